@@ -1,7 +1,15 @@
 #include "CppUnitTest.h"
 #include <filesystem>
+#include "generic/CountryAdjacency.h"
+#include "generic/FlagAtlas.h"
+#include "generic/LabelRasters.h"
 #include "generic/NameGenerator.h"
 #include "generic/ParserUtils.h"
+#include "generic/ProvinceTable.h"
+#include "generic/RandomStream.h"
+#include "generic/RegionPool.h"
+#include "generic/Snapshot.h"
+#include "generic/TaskGraph.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -25,6 +33,19 @@ namespace PdoxTest
 		TEST_METHOD(GenerateAdjective) {
 			// TODO
 		}
+		TEST_METHOD(GenerateNamesInBulk)
+		{
+			auto nData = Scenario::NameGeneration::prepare(nameDir.string());
+			const auto names = Scenario::NameGeneration::generateNames(nData, 1000, "test", 1, 1);
+			Assert::AreEqual(names.size(), size_t{ 1000 });
+			// the same seed and stage give the same names, however they were split up
+			for (const auto numThreads : { 3u, 7u }) {
+				const auto split = Scenario::NameGeneration::generateNames(nData, 1000, "test", 1, numThreads);
+				Assert::AreEqual(split.size(), names.size());
+				for (auto i = 0; i < names.size(); i++)
+					Assert::IsTrue(names[i] == split[i]);
+			}
+		}
 	};
 	TEST_CLASS(ParserTest)
 	{
@@ -114,4 +135,217 @@ namespace PdoxTest
 			Assert::AreEqual(empty, { "" });
 		}
 	};
+	TEST_CLASS(TaskGraphTest)
+	{
+	public:
+		TEST_METHOD(DependenciesRunInOrder)
+		{
+			Scenario::TaskGraph graph(4);
+			std::vector<int> order;
+			std::mutex orderMutex;
+			auto first = graph.add("first", [&] { std::lock_guard<std::mutex> lock(orderMutex); order.push_back(0); });
+			for (auto i = 0; i < 10; i++)
+				graph.add("independent", [&] { std::lock_guard<std::mutex> lock(orderMutex); order.push_back(2); });
+			graph.add("second", [&] { std::lock_guard<std::mutex> lock(orderMutex); order.push_back(1); }, { first });
+			graph.run();
+			Assert::AreEqual(order.size(), size_t{ 12 });
+			auto firstPos = std::find(order.begin(), order.end(), 0);
+			auto secondPos = std::find(order.begin(), order.end(), 1);
+			Assert::IsTrue(firstPos < secondPos);
+		}
+		TEST_METHOD(ChunksCoverEveryIndexOnce)
+		{
+			for (const auto numThreads : { 1u, 3u, 64u }) {
+				std::vector<int> visits(37, 0);
+				Scenario::TaskGraph::parallelFor("chunks", 37, numThreads, [&](int chunk, int first, int end) {
+					for (auto i = first; i < end; i++)
+						visits[i]++;
+				});
+				Assert::IsTrue(visits == std::vector<int>(37, 1));
+			}
+			Assert::AreEqual(Scenario::TaskGraph::chunkCount(37, 1), 1);
+		}
+	};
+	TEST_CLASS(SnapshotTest)
+	{
+	public:
+		TEST_METHOD(ValuesSurviveRoundTrip)
+		{
+			using namespace Scenario::Snapshot;
+			const auto path = std::filesystem::temp_directory_path() / "test.snapshot";
+			const std::map<std::string, std::vector<double>> values{ { "a", { 1.0, 2.5 } }, { "b", {} } };
+			{
+				Writer writer(path.string(), "Test");
+				writer.write(42);
+				writer.write(values);
+			}
+			Reader reader(path.string(), "Test");
+			Assert::AreEqual(reader.get<int>(), 42);
+			Assert::IsTrue(reader.get<std::map<std::string, std::vector<double>>>() == values);
+			// reading beyond the end or as another type must fail
+			Assert::ExpectException<std::exception>([&] { reader.get<int>(); });
+			Assert::ExpectException<std::exception>([&] { Reader other(path.string(), "Other"); });
+		}
+	};
+	TEST_CLASS(ProvinceTableTest)
+	{
+	public:
+		TEST_METHOD(NeighboursAreStoredByID)
+		{
+			// a chain of three provinces, handed over out of order
+			std::vector<Fwg::Province> provinces(3);
+			for (auto i = 0; i < provinces.size(); i++)
+				provinces[i].ID = i;
+			provinces[0].neighbours = { &provinces[1] };
+			provinces[1].neighbours = { &provinces[0], &provinces[2] };
+			provinces[2].neighbours = { &provinces[1] };
+			Scenario::ProvinceTable provinceTable;
+			provinceTable.build({ &provinces[2], &provinces[0], &provinces[1] }, 4);
+			Assert::AreEqual(provinceTable.size(), 3);
+			Assert::IsTrue(provinceTable.baseProvinces[2] == &provinces[2]);
+			const auto neighbours = provinceTable.neighbours(1);
+			Assert::IsTrue(std::vector<int>(neighbours.begin(), neighbours.end()) == std::vector<int>{ 0, 2 });
+			Assert::AreEqual(provinceTable.owners[0], -1);
+			provinceTable.setTerrainType(0, "hills");
+			Assert::AreEqual(provinceTable.terrainType(0), std::string("hills"));
+			Assert::ExpectException<std::exception>([&] { provinceTable.setTerrainType(0, "ocean"); });
+		}
+		TEST_METHOD(AttributesAreInterned)
+		{
+			std::vector<Fwg::Province> provinces(2);
+			provinces[1].ID = 1;
+			Scenario::ProvinceTable provinceTable;
+			provinceTable.build({ &provinces[0], &provinces[1] }, 4);
+			// known attributes keep their ID, free-form keys get a new column once
+			Assert::AreEqual(provinceTable.doubleAttributeID("naval_bases"), (int)Scenario::ProvinceTable::navalBases);
+			const auto custom = provinceTable.doubleAttributeID("custom");
+			Assert::AreEqual(provinceTable.doubleAttributeID("custom"), custom);
+			Assert::AreEqual(provinceTable.doubleAttributes[custom].size(), size_t{ 2 });
+			provinceTable.stringAttributes[provinceTable.stringAttributeID("culture")][1] = "north";
+			Assert::AreEqual(provinceTable.stringAttributes[0][1], std::string("north"));
+		}
+		TEST_METHOD(PixelsAreStoredAsRowSpans)
+		{
+			// on a 4 pixel wide map: the end of row 0, all of row 1 and a gap in row 2
+			std::vector<Fwg::Province> provinces(1);
+			provinces[0].pixels = { 9, 2, 3, 4, 5, 6, 7, 11 };
+			Scenario::ProvinceTable provinceTable;
+			provinceTable.build({ &provinces[0] }, 4);
+			const auto spans = provinceTable.spans(0);
+			Assert::AreEqual(spans.size(), size_t{ 4 });
+			Assert::AreEqual(spans[0].start, 2);
+			Assert::AreEqual(spans[1].length, 4);
+			Assert::AreEqual(spans[3].row, 2);
+			Assert::AreEqual(Scenario::pixelCount(spans), 8);
+			std::vector<int> pixels;
+			Scenario::forEachPixel(spans, provinceTable.width, [&](const int pix) { pixels.push_back(pix); });
+			Assert::IsTrue(pixels == std::vector<int>{ 2, 3, 4, 5, 6, 7, 9, 11 });
+		}
+		TEST_METHOD(RegionLabelsAreDerivedFromProvinceLabels)
+		{
+			// two provinces on a 3x2 map, the last pixel belongs to neither
+			const std::vector<Scenario::PixelSpan> first{ { 0, 0, 2 } }, second{ { 0, 2, 1 }, { 1, 0, 2 } };
+			Scenario::LabelRasters labels;
+			labels.build({ first, second }, 3, 2);
+			Assert::IsTrue(labels.provinces == std::vector<std::uint32_t>{ 0, 0, 1, 1, 1, Scenario::LabelRasters::none });
+			const auto regions = labels.derive(labels.provinces, { 7, 4 });
+			Assert::IsTrue(regions == std::vector<std::uint32_t>{ 7, 7, 4, 4, 4, Scenario::LabelRasters::none });
+		}
+	};
+	TEST_CLASS(RegionPoolTest)
+	{
+	public:
+		TEST_METHOD(RemovedRegionsAreSwappedOut)
+		{
+			// four regions, of which only the land regions 0, 2 and 3 are free
+			std::vector<Scenario::Region> regions(4);
+			for (auto i = 0; i < regions.size(); i++) {
+				regions[i].ID = i;
+				regions[i].sea = i == 1;
+			}
+			Scenario::RegionPool freeRegions;
+			freeRegions.build(regions);
+			Assert::AreEqual(freeRegions.size(), 3);
+			Assert::IsFalse(freeRegions.contains(1));
+			freeRegions.remove(0);
+			freeRegions.remove(0);
+			Assert::AreEqual(freeRegions.size(), 2);
+			Assert::IsFalse(freeRegions.contains(0));
+			Assert::IsTrue(freeRegions.contains(2) && freeRegions.contains(3));
+			freeRegions.remove(3);
+			Assert::AreEqual(freeRegions.random(), 2);
+			freeRegions.remove(2);
+			Assert::IsTrue(freeRegions.empty());
+		}
+	};
+	TEST_CLASS(CountryAdjacencyTest)
+	{
+	public:
+		TEST_METHOD(BordersFollowOwnerChanges)
+		{
+			// a chain of three regions, the middle one changes hands
+			std::vector<Scenario::Region> regions(3);
+			for (auto i = 0; i < regions.size(); i++)
+				regions[i].ID = i;
+			regions[0].neighbours = { 1 };
+			regions[1].neighbours = { 0, 2 };
+			regions[2].neighbours = { 1 };
+			Scenario::CountryAdjacency adjacency;
+			adjacency.reset(2);
+			for (const auto [regionID, owner] : { std::pair{ 0, 0 }, { 1, 1 }, { 2, 0 } }) {
+				regions[regionID].owner = owner;
+				adjacency.changeOwner(regions, regions[regionID], -1);
+			}
+			Assert::IsTrue(adjacency.neighbours(1, 0));
+			Assert::AreEqual(adjacency.borderCount(0, 1), 2);
+			regions[1].owner = 0;
+			adjacency.changeOwner(regions, regions[1], 1);
+			Assert::IsFalse(adjacency.neighbours(0, 1));
+			Assert::AreEqual(adjacency.borderCount(1, 0), 0);
+		}
+	};
+	TEST_CLASS(RandomStreamTest)
+	{
+	public:
+		TEST_METHOD(PhiloxKnownAnswers)
+		{
+			// known answers of the Random123 reference implementation
+			auto block = Scenario::RandomStream::philox({ 0, 0, 0, 0 }, { 0, 0 });
+			Assert::IsTrue(block == Scenario::RandomStream::Block{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+			block = Scenario::RandomStream::philox({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 });
+			Assert::IsTrue(block == Scenario::RandomStream::Block{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+		}
+		TEST_METHOD(StreamsDependOnlyOnTheirKey)
+		{
+			Scenario::RandomStream first(7, "stage", 1), other(7, "stage", 2), again(7, "stage", 1);
+			// drawing from another stream in between changes nothing
+			const auto value = first.next();
+			other.next();
+			Assert::AreEqual(again.next(), value);
+			Assert::AreEqual(first.getRandom(4, 4), 4);
+		}
+		TEST_METHOD(DoubleDrawsAreStable)
+		{
+			// the high bits come from the first word, on every compiler
+			Scenario::RandomStream random(7, "stage", 1);
+			Assert::AreEqual(random.getRandom(0.0, 1.0), 0x1.e0c51cf0b45fep-1);
+			Assert::AreEqual(random.getRandom(2.0, 4.0), 0x1.351e4d1bbf7e4p+1);
+		}
+	};
+	TEST_CLASS(FlagAtlasTest)
+	{
+	public:
+		TEST_METHOD(FlagsAreSampledFromTheAtlas)
+		{
+			// two flags of 4x2 pixels, the blue channel holds the pixel index
+			Scenario::Gfx::FlagAtlas flagAtlas(4, 2);
+			flagAtlas.pixels.resize(2 * 4 * 2 * 4);
+			for (auto pixel = 0; pixel < 16; pixel++)
+				flagAtlas.pixels[pixel * 4] = pixel;
+			Assert::AreEqual(flagAtlas.size(), 2);
+			Assert::AreEqual((int)flagAtlas.flag(1)[0], 8);
+			const auto resized = flagAtlas.resize(1, 2, 1);
+			Assert::IsTrue(resized == std::vector<uint8_t>{ 8, 0, 0, 0, 10, 0, 0, 0 });
+		}
+	};
 }
@@ -5,11 +5,23 @@
 #include "generic/FormatConverter.h"
 #include "generic/GenericModule.h"
 #include "generic/ScenarioGenerator.h"
+#include "generic/TaskGraph.h"
 namespace Scenario::Eu4 {
 class Module : GenericModule {
   Generator eu4Gen;
+  std::string configSubFolder;
+  // resources that stay the same for every generated scenario
+  NameGeneration::NameData nameData;
+  Gfx::FormatConverter formatConverter;
+  // fwg settings of eu4, scaled from the fwg config once
+  double seaProvFactor;
+  double landProvFactor;
   // clear and create all the mod paths at each run
   bool createPaths();
+  // the fwg settings of the eu4 config
+  void applyFwgOverrides();
+  // run the world generation and hand the world to a fresh generator
+  void generateWorld();
   // read the config options specific to eu4
   void readEu4Config(const std::string &configSubFolder,
                      const std::string &username,
@@ -21,5 +33,9 @@ public:
   ~Module();
   // member functions
   void genEu4();
+  // generate one scenario per seed, each into its own mod folder
+  void genEu4Batch(const int firstSeed, const int lastSeed);
+  // generate one scenario with the overrides of a daemon job
+  void genEu4Job(const boost::property_tree::ptree &job);
 };
 } // namespace Scenario::Eu4
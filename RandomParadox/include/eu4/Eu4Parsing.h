@@ -14,7 +14,7 @@ void writeAmbientObjects(const std::string &path,
 void writeAreas(const std::string &path, const std::vector<Region> &regions,
                 const std::string &gamePath);
 void writeClimate(const std::string &path,
-                  const std::vector<GameProvince> &provinces);
+                  const ProvinceTable &provinceTable);
 void writeColonialRegions(const std::string &path, const std::string &gamePath,
                           const std::vector<GameProvince> &provinces);
 // continents consist of multiple provinces
@@ -45,6 +45,7 @@ void copyDescriptorFile(const std::string &sourcePath,
 
 void writeProvinces(const std::string &path,
                     const std::vector<GameProvince> &provinces,
+                    const ProvinceTable &provinceTable,
                     const std::vector<Region> &regions);
 
 void writeLoc(const std::string &path, const std::string &gamePath,
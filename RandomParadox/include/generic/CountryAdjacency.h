@@ -0,0 +1,37 @@
+#pragma once
+#include "generic/GameRegion.h"
+#include "generic/PdoxCountry.h"
+#include <boost/dynamic_bitset.hpp>
+#include <vector>
+namespace Scenario {
+// which countries border each other, kept up to date region by region. For
+// every pair of countries it counts the region borders between them, a
+// country's row has a bit set for every country it has at least one border
+// with
+class CountryAdjacency {
+  // vars
+  int countryCount = 0;
+  // containers
+  // countryCount x countryCount, row by row
+  std::vector<int> borderCounts;
+  std::vector<boost::dynamic_bitset<>> rows;
+  // add count borders between the two countries, count may be negative
+  void addBorders(const CountryId first, const CountryId second,
+                  const int count);
+
+public:
+  // constructors/destructors
+  CountryAdjacency();
+  ~CountryAdjacency();
+  // forget all borders and make room for this many countries
+  void reset(const int countryCount);
+  // account for the region changing from previousOwner to region.owner. Either
+  // may be -1 for no owner
+  void changeOwner(const std::vector<Region> &gameRegions, const Region &region,
+                   const CountryId previousOwner);
+  bool neighbours(const CountryId first, const CountryId second) const;
+  int borderCount(const CountryId first, const CountryId second) const;
+  // indexed by CountryId
+  const boost::dynamic_bitset<> &row(const CountryId country) const;
+};
+} // namespace Scenario
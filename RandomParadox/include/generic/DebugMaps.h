@@ -0,0 +1,18 @@
+#pragma once
+#include "FastWorldGenerator.h"
+#include <functional>
+#include <string>
+namespace Scenario::DebugMaps {
+// true if debug maps are written at all, see Cfg::writeMaps. Check it before
+// copying data for a render
+bool enabled();
+// queue a debug map. Nothing happens if debug maps are disabled, otherwise
+// render is called on a background thread and its bitmap saved to path. Maps
+// are rendered one after another in the order they were queued. render must
+// own everything it reads, the generation carries on meanwhile
+void save(const std::string &path,
+          std::function<Fwg::Gfx::Bitmap()> render);
+// wait until all queued maps are written. Rethrows the first exception of a
+// render or save, maps queued after it are dropped
+void flush();
+} // namespace Scenario::DebugMaps
@@ -1,6 +1,7 @@
 #pragma once
 #include "FastWorldGenerator.h"
 #include "ParserUtils.h"
+#include "RandomStream.h"
 #include "Textures.h"
 
 namespace Scenario::Gfx {
@@ -16,6 +17,24 @@ struct SymbolInfo {
   bool replaceColour;
 };
 
+// a template with every colour replaced by its palette ID: the rank of the
+// colour among all colours of the template, in the order of a colour map
+struct PaletteTemplate {
+  // marks pixels of symbols that are left out
+  static constexpr uint8_t transparent = 255;
+  std::vector<uint8_t> paletteIDs;
+  int paletteSize;
+};
+
+// where the symbol goes on a flag template. Only depends on the reduction
+// factor and the offsets of the template, so it is computed once per template
+struct SymbolPlacement {
+  // pixels of the symbol template that are sampled for the reduced size
+  std::vector<int> sources;
+  // byte offset in the flag for each sampled pixel, -1 if it is outside
+  std::vector<int> targets;
+};
+
 class Flag {
   // keep code shorter
   // static cause we only want to read them from file once
@@ -26,6 +45,11 @@ class Flag {
   static std::vector<FlagInfo> flagMetadata;
   static std::vector<SymbolInfo> symbolMetadata;
   static std::vector<std::vector<uint8_t>> symbolTemplates;
+  // the templates above, converted once when they are read
+  static std::vector<PaletteTemplate> flagPalettes;
+  static std::vector<PaletteTemplate> symbolPalettes;
+  static std::vector<SymbolPlacement> symbolPlacements;
+  static bool resourcesLoaded;
   // containers
   std::vector<Fwg::Gfx::Colour> colours;
   std::vector<unsigned char> image;
@@ -36,7 +60,8 @@ public:
   int height;
   // constructors/destructors
   Flag();
-  Flag(const int width, const int height);
+  // a random flag, all random numbers are drawn from the stream
+  Flag(const int width, const int height, RandomStream &random);
   ~Flag();
   // methods - image read/write
   void setPixel(const Fwg::Gfx::Colour colour, const int x, const int y);
@@ -49,9 +74,18 @@ public:
          const std::vector<unsigned char> tImage, const int inWidth,
          const int inHeight);
   // methods - read in configs
+  // reads all of the below, only the first call does any work
+  static void readResources();
   static void readColourGroups();
   static void readFlagTypes();
   static void readFlagTemplates();
   static void readSymbolTemplates();
+  // convert a BGRA template. Pixels without alpha are transparent if
+  // skipTransparent is set, else they take part like all others
+  static PaletteTemplate compileTemplate(const std::vector<uint8_t> &image,
+                                         const bool skipTransparent);
+  // place the symbol on a flag template of imageSize bytes
+  static SymbolPlacement placeSymbol(const FlagInfo &flagInfo,
+                                     const int imageSize);
 };
 } // namespace Scenario::Gfx
\ No newline at end of file
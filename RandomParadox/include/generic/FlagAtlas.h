@@ -0,0 +1,31 @@
+#pragma once
+#include "Flag.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+namespace Scenario::Gfx {
+// the flags of all countries in one buffer, one BGRA image after the other.
+// Countries only keep the index of their flag
+class FlagAtlas {
+public:
+  // vars
+  int width;
+  int height;
+  // containers
+  std::vector<uint8_t> pixels;
+  // constructors/destructors
+  FlagAtlas();
+  FlagAtlas(const int width, const int height);
+  ~FlagAtlas();
+  // member functions
+  int size() const;
+  // replace all flags by count new ones, generated on numThreads workers. A
+  // flag only depends on the seed and its index
+  void generate(const int count, const std::uint32_t seed,
+                const unsigned int numThreads);
+  std::span<const uint8_t> flag(const int index) const;
+  // the flag sampled down to the given size, a copy at the full size
+  std::vector<uint8_t> resize(const int index, const int width,
+                              const int height) const;
+};
+} // namespace Scenario::Gfx
@@ -17,6 +17,7 @@ class FormatConverter {
 
 public:
   // constructor/destructor
+  FormatConverter();
   FormatConverter(const std::string &gamePath, const std::string &gameTag);
   ~FormatConverter();
   // member functions
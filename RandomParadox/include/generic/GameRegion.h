@@ -8,11 +8,11 @@ class Region : public Fwg::Region {
 
 public:
   // member variables
-  std::string owner;
+  // ID of the owning country, -1 if not owned
+  int owner;
   std::string name;
   bool assigned;
   // containers
-  std::vector<GameProvince> gameProvinces;
   std::vector<double> temperatureRange;
   std::vector<double> dateRange;
   double snowChance, lightRainChance, heavyRainChance, blizzardChance,
@@ -1,21 +1,35 @@
 #pragma once
 #include "generic/ParserUtils.h"
+#include "utils/Cfg.h"
 #include "utils/Logging.h"
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <filesystem>
+#include <functional>
 #include <string>
 namespace Scenario {
+// unattended runs, like the daemon and batches, must never wait for a key. On
+// Windows a pause also reads from stdin, which carries the jobs of the daemon
+void setInteractive(const bool interactive);
+// wait for a key press, does nothing if the run is not interactive
+void pause();
 class GenericModule {
 
 protected:
   int numCountries;
+  // regions a country grows to from its start region
+  int regionsPerCountry;
+  // worker threads for the output phase, 0 uses all hardware threads
+  unsigned int numThreads;
   bool cut;
   std::string modName;
   std::string gamePath;
   std::string gameModPath;
   std::string gameModsDirectory;
   std::string mappingPath;
+  // maps loaded by fwg instead of generating them, from the module config
+  std::string loadMapsPath;
+  std::string heightmapIn;
   void configurePaths(const std::string &username, const std::string &gameName,
                   const boost::property_tree::ptree &gamesConf);
   void createPaths(const std::string &basePath);
@@ -24,5 +38,14 @@ protected:
   bool findGame(std::string &path, const std::string &game);
   // check if configured mod directories are correct
   bool findModFolders();
+  // set the seed and writeMaps of a run in the fwg config. The layer seeds are
+  // derived from the seed and the global RNG is reseeded, so a run with a
+  // given seed doesn't depend on the runs before it
+  void applyRunSettings(const int seed, const bool writeMaps);
+  // run a generation with the overrides of a job applied: seed, name,
+  // numCountries and writeMaps. The mod is written to <modName>_<name>, or
+  // <modName>_<seed> if no name is given. Settings are restored afterwards
+  void runJob(const boost::property_tree::ptree &job,
+              const std::function<void()> &generate);
 };
 } // namespace Scenario
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include "PixelSpans.h"
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+namespace Scenario {
+// one label per pixel, row by row, for whole image passes. The province
+// raster is painted once from the pixel spans, region and country rasters are
+// derived from it through lookup tables
+class LabelRasters {
+public:
+  // label of pixels that belong to no province, region or country
+  static constexpr std::uint32_t none = UINT32_MAX;
+  // vars
+  int width = 0;
+  int height = 0;
+  // workers of forEachBand, 0 uses all hardware threads, 1 is sequential
+  unsigned int numThreads = 0;
+  // rasters
+  std::vector<std::uint32_t> provinces;
+  std::vector<std::uint32_t> regions;
+  std::vector<std::uint32_t> countries;
+  // constructors/destructors
+  LabelRasters();
+  ~LabelRasters();
+  // paint the province raster from the pixel spans of every province,
+  // indexed by province ID
+  void build(const std::vector<std::span<const PixelSpan>> &provinceSpans,
+             const int width, const int height);
+  // map every label of source through lookup, none stays none
+  std::vector<std::uint32_t>
+  derive(const std::vector<std::uint32_t> &source,
+         const std::vector<std::uint32_t> &lookup) const;
+  // number of row bands forEachBand splits the image into
+  int bandCount() const;
+  // run sweep(band, firstRow, endRow) for bands of rows concurrently. Bands
+  // never share pixels, so sweeps may write per pixel data without locking
+  void forEachBand(
+      const std::function<void(int band, int firstRow, int endRow)> &sweep)
+      const;
+};
+} // namespace Scenario
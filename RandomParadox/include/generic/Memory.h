@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+namespace Scenario::Memory {
+struct Usage {
+  // resident set size of the process, in bytes
+  std::size_t current;
+  // highest resident set size since the start of the process, in bytes
+  std::size_t peak;
+};
+struct Allocations {
+  unsigned long long count;
+  unsigned long long bytes;
+};
+Usage getUsage();
+// allocations made by the calling thread through the global operator new,
+// plus those added to it. Only counted when built with RPD_COUNT_ALLOCATIONS,
+// otherwise always zero
+Allocations getAllocations();
+// count the allocations of another thread, e.g. a worker that was joined, as
+// allocations of the calling thread
+void addAllocations(const Allocations &allocations);
+} // namespace Scenario::Memory
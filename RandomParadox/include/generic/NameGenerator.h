@@ -4,6 +4,8 @@
 #include "ResourceLoading.h"
 #include <map>
 #include <string>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 namespace Scenario {
 namespace NameGeneration {
@@ -15,8 +17,27 @@ struct NameData {
   std::map<std::string, std::vector<std::string>> ideologyNames;
   std::map<std::string, std::vector<std::string>> factionNames;
 };
+// names stored back to back in one buffer
+class NameList {
+  std::string characters;
+  // name i is characters[offsets[i]] to characters[offsets[i + 1] - 1]
+  std::vector<size_t> offsets{0};
+  friend NameList generateNames(const NameData &nameData, const size_t count,
+                                const std::string &stage,
+                                const std::uint32_t seed,
+                                const unsigned int numThreads);
+
+public:
+  size_t size() const;
+  std::string_view operator[](const size_t i) const;
+};
 // member functions
 std::string generateName(const NameData &nameData);
+// count names, generated in parallel on numThreads workers. Name i only
+// depends on the seed, stage and i, not on the number of threads
+NameList generateNames(const NameData &nameData, const size_t count,
+                       const std::string &stage, const std::uint32_t seed,
+                       const unsigned int numThreads);
 std::string generateAdjective(const std::string &name,
                               const NameData &nameData);
 std::string generateTag(const std::string name, 
@@ -1,36 +1,43 @@
 #pragma once
 #include "FastWorldGenerator.h"
-#include "generic/Flag.h"
 #include "generic/GameRegion.h"
+#include "generic/ProvinceTable.h"
+#include "generic/RegionPool.h"
 #include "RandNum/RandNum.h"
+#include <boost/dynamic_bitset.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 namespace Scenario {
+// countries are numbered densely, the ID is their index in the country tables
+using CountryId = int;
+// the letters of a tag packed into one integer, one byte each
+std::uint32_t packTag(const std::string &tag);
 class PdoxCountry {
 public:
   // member variables
-  const int ID;
+  CountryId ID;
   std::string tag;
   std::string name;
   std::string adjective;
   int capitalRegionID;
   double developmentFactor;
-  Gfx::Flag flag;
+  // index of the flag in the flag atlas of the generator
+  int flagIndex;
   Fwg::Gfx::Colour colour;
   // constructors/destructors
   PdoxCountry();
   PdoxCountry(std::string tag, int ID, std::string name, std::string adjective,
-              Gfx::Flag flag);
+              int flagIndex);
   ~PdoxCountry();
   // containers
   std::vector<int> ownedRegions;
-  std::set<std::string> neighbours;
+  // indexed by CountryId
+  boost::dynamic_bitset<> neighbours;
   // member functions
+  // take ownership of the region and remove it from the free regions
   void addRegion(Region &region, std::vector<Region> &gameRegions,
-                 std::vector<GameProvince> &gameProvinces);
-  void assignRegions(int maxRegions, std::vector<Region> &gameRegions,
-                     Region &startRegion,
-                     std::vector<GameProvince> &gameProvinces);
+                 ProvinceTable &provinceTable, RegionPool &freeRegions);
   // operators
   bool operator<(const PdoxCountry &right) const { return ID < right.ID; };
 };
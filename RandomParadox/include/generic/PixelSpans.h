@@ -0,0 +1,30 @@
+#pragma once
+#include "FastWorldGenerator.h"
+#include <span>
+#include <vector>
+namespace Scenario {
+// a run of pixels along one row of a map: pixel indices
+// row * width + start to row * width + start + length - 1
+struct PixelSpan {
+  int row;
+  int start;
+  int length;
+};
+// encode pixel indices of a map of this width as runs, sorted by row and start
+std::vector<PixelSpan> toSpans(std::vector<int> pixels, const int width);
+// number of pixels covered by the spans
+int pixelCount(std::span<const PixelSpan> spans);
+// call visit with every pixel index covered by the spans, row by row
+template <typename Visitor>
+void forEachPixel(std::span<const PixelSpan> spans, const int width,
+                  Visitor &&visit) {
+  for (const auto &span : spans) {
+    const auto first = span.row * width + span.start;
+    for (auto pix = first; pix < first + span.length; pix++)
+      visit(pix);
+  }
+}
+// set all pixels covered by the spans to colour, one contiguous fill per span
+void fill(Fwg::Gfx::Bitmap &bitmap, std::span<const PixelSpan> spans,
+          const Fwg::Gfx::Colour &colour);
+} // namespace Scenario
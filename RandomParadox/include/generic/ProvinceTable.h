@@ -0,0 +1,67 @@
+#pragma once
+#include "FastWorldGenerator.h"
+#include "PixelSpans.h"
+#include <map>
+#include <span>
+namespace Scenario {
+// the per province data of a scenario in flat columns, indexed by province ID.
+// Adjacency is kept in compressed sparse row form: the neighbours of province
+// ID are neighbourIDs[neighbourOffsets[ID]] to
+// neighbourIDs[neighbourOffsets[ID + 1] - 1]. The pixels of a province are
+// stored the same way, as row runs in pixelSpans
+class ProvinceTable {
+public:
+  // terrain IDs index into this, 0 means the terrain was not mapped
+  static const std::vector<std::string> terrainTypes;
+  // columns
+  std::vector<const Fwg::Province *> baseProvinces;
+  // ID of the owning country, -1 if not owned
+  std::vector<int> owners;
+  std::vector<unsigned char> terrainIDs;
+  std::vector<double> popFactors;
+  std::vector<double> devFactors;
+  std::vector<double> cityShares;
+  // raster statistics, gathered in one pass over the maps
+  std::vector<int> areas;
+  std::vector<int> cityPixels;
+  // population and city density maps at a sample pixel, relative to their
+  // full colours
+  std::vector<double> populationSamples;
+  std::vector<double> cityDensities;
+  // the distinct climate colours, sorted, and how many pixels of each
+  // province have them: climateHistograms[ID * climatePalette.size() + i]
+  // counts climatePalette[i]
+  std::vector<Fwg::Gfx::Colour> climatePalette;
+  std::vector<int> climateHistograms;
+  // adjacency
+  std::vector<int> neighbourOffsets;
+  std::vector<int> neighbourIDs;
+  // pixels
+  int width = 0;
+  std::vector<int> spanOffsets;
+  std::vector<PixelSpan> pixelSpans;
+  // attributes known ahead of time, their columns exist from the start
+  enum DoubleAttribute { navalBases, knownDoubleAttributes };
+  // one column per attribute, indexed by province ID. Free-form keys get
+  // their column on first use of their ID
+  std::vector<std::vector<double>> doubleAttributes;
+  std::vector<std::vector<std::string>> stringAttributes;
+  std::map<std::string, int> doubleAttributeIDs;
+  std::map<std::string, int> stringAttributeIDs;
+  // constructors/destructors
+  ProvinceTable();
+  ~ProvinceTable();
+  // size all columns for these provinces and build their adjacency and pixel
+  // runs on a map of this width
+  void build(const std::vector<Fwg::Province *> &provinces, const int width);
+  int size() const;
+  std::span<const int> neighbours(const int ID) const;
+  std::span<const PixelSpan> spans(const int ID) const;
+  const std::string &terrainType(const int ID) const;
+  void setTerrainType(const int ID, const std::string &terrainType);
+  // intern the key, adding an empty column if it is new. Look the ID up once
+  // outside of province loops
+  int doubleAttributeID(const std::string &key);
+  int stringAttributeID(const std::string &key);
+};
+} // namespace Scenario
@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+namespace Scenario {
+// counter based random numbers (Philox4x32-10). A stream is keyed by the
+// seed, a stage and an entity of that stage, its numbers only depend on that
+// key. Streams of different entities can be drawn from in any order and on
+// any thread without changing the output
+class RandomStream {
+public:
+  using Block = std::array<std::uint32_t, 4>;
+  using Key = std::array<std::uint32_t, 2>;
+
+private:
+  Key key;
+  Block counter;
+  Block block;
+  // numbers of the current block handed out already
+  int used = 4;
+
+public:
+  // the Philox4x32-10 block of this counter and key
+  static Block philox(Block counter, Key key);
+  // stable for the same name, across runs and platforms
+  static std::uint32_t stageKey(const std::string &stage);
+  // constructors/destructors
+  RandomStream(const std::uint32_t seed, const std::string &stage,
+               const std::uint32_t entity);
+  ~RandomStream();
+  std::uint32_t next();
+  // uniform in [min, max]
+  int getRandom(const int min, const int max);
+  // uniform in [min, max)
+  double getRandom(const double min, const double max);
+  template <typename T> const T &selectRandom(const std::vector<T> &values) {
+    return values[getRandom(0, (int)values.size() - 1)];
+  }
+};
+} // namespace Scenario
@@ -0,0 +1,28 @@
+#pragma once
+#include "generic/GameRegion.h"
+#include <vector>
+namespace Scenario {
+// the land regions nobody owns yet. Picking a random one and removing one are
+// both constant time, removal swaps the last region into the freed slot
+class RegionPool {
+  // containers
+  std::vector<int> regionIDs;
+  // position of each region in regionIDs, indexed by region ID. -1 if the
+  // region is not in the pool
+  std::vector<int> slots;
+
+public:
+  // constructors/destructors
+  RegionPool();
+  ~RegionPool();
+  // fill with all unassigned land regions
+  void build(const std::vector<Region> &gameRegions);
+  bool empty() const;
+  int size() const;
+  bool contains(const int regionID) const;
+  // does nothing if the region is not in the pool
+  void remove(const int regionID);
+  // ID of a random region in the pool, which must not be empty
+  int random();
+};
+} // namespace Scenario
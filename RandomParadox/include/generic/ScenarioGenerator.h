@@ -1,14 +1,24 @@
 #pragma once
 #include "FastWorldGenerator.h"
-#include "Flag.h"
+#include "CountryAdjacency.h"
+#include "DebugMaps.h"
+#include "FlagAtlas.h"
 #include "GameProvince.h"
 #include "GameRegion.h"
+#include "LabelRasters.h"
 #include "NameGenerator.h"
 #include "PdoxContinent.h"
 #include "PdoxCountry.h"
+#include "ProvinceTable.h"
+#include "RandomStream.h"
+#include "RegionPool.h"
 #include "ResourceLoading.h"
+#include "Tracing.h"
 #include "RandNum/RandNum.h"
+#include <deque>
 #include <map>
+#include <memory>
+#include <queue>
 namespace Scenario {
 class Generator {
   // containers
@@ -20,21 +30,42 @@ public:
   Generator();
   // vars - used for every game
   NameGeneration::NameData nData;
-  Fwg::FastWorldGenerator fwg;
+  // shared with the module that generated the world, never copied
+  std::shared_ptr<Fwg::FastWorldGenerator> fwg;
   int numCountries;
+  // workers of the parallel stages, 0 uses all hardware threads, 1 is
+  // sequential
+  unsigned int numThreads = 0;
   // containers - used for every game
   std::vector<Fwg::Province *> provinces;
   std::vector<PdoxContinent> pdoxContinents;
   std::vector<Region> gameRegions;
+  // land regions without an owner, while countries are generated
+  RegionPool freeRegions;
+  // sorted by ID, regions refer to these through the IDs of their provinces
   std::vector<GameProvince> gameProvinces;
+  // flat per province data, indexed by province ID
+  ProvinceTable provinceTable;
+  // province, region and country ID per pixel
+  LabelRasters labels;
   std::set<std::string> tags;
-  std::map<std::string, PdoxCountry> countries;
+  // indexed by CountryId
+  std::vector<PdoxCountry> countries;
+  // packed tag to CountryId
+  std::map<std::uint32_t, CountryId> countryIDs;
+  // borders between countries, updated whenever a region changes owner
+  CountryAdjacency countryAdjacency;
+  // the flags of all countries, indexed by PdoxCountry::flagIndex
+  Gfx::FlagAtlas flagAtlas{82, 52};
   // constructors/destructors
-  Generator(Fwg::FastWorldGenerator &fwg);
+  Generator(std::shared_ptr<Fwg::FastWorldGenerator> fwg);
   ~Generator();
   /* member functions*/
-  // print a map showing all countries for debug purposes
-  Fwg::Gfx::Bitmap dumpDebugCountrymap(const std::string &path);
+  // renders a map showing all countries, from a copy of the current
+  // ownership so it can run in the background
+  std::function<Fwg::Gfx::Bitmap()> countryMapRenderer() const;
+  // queue a map showing all countries for debug purposes
+  void dumpDebugCountrymap(const std::string &path);
   // specific preparations. Used by each game, BUT to create game scenario
   void loadRequiredResources(const std::string &gamePath);
   // generic preparations. However, if desired, there are necessary preparations
@@ -45,6 +76,12 @@ public:
   void mapContinents();
   // map base regions to generic paradox compatible game regions
   void mapRegions();
+  // paint the province raster and derive the region raster from it
+  void buildLabelRasters();
+  // derive the country raster once regions have their owners
+  void labelCountries();
+  // gather the raster statistics of all provinces in one pass over the maps
+  void gatherProvinceStatistics();
   // calculating populations in states
   void generatePopulations();
   // determine development from habitability, population density and randomness
@@ -54,8 +91,19 @@ public:
   // GameRegions are used for every single game,
   Region &findStartRegion();
   // and countries are always created the same way
-  void generateCountries(int numCountries, const std::string &gamePath);
+  void generateCountries(int numCountries, int regionsPerCountry,
+                         const std::string &gamePath);
+  // grow all countries at once from their start regions. The smallest country
+  // always takes the next region, ties are broken randomly
+  void growCountries(int regionsPerCountry);
+  // give every unowned land region to the closest country along the region
+  // graph, falling back to the nearest owned land across water
+  void assignLeftoverRegions();
+  // give the region to the country, keeping the country adjacency up to date
+  void assignRegion(Region &region, PdoxCountry &country);
   // see which country neighbours which
   void evaluateNeighbours();
+  // throws if no country has this tag
+  CountryId countryID(const std::string &tag) const;
 };
 } // namespace Scenario
@@ -0,0 +1,108 @@
+#pragma once
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+namespace Scenario::Snapshot {
+// marks the start of every snapshot file
+constexpr unsigned int magic = 0x50535044;
+// bump when the layout of any snapshot changes, old snapshots are rejected
+constexpr unsigned int version = 7;
+
+// writes values in native binary layout, containers are prefixed with their
+// size. Snapshots are only meant to be read by the same build
+class Writer {
+  std::ofstream file;
+
+public:
+  Writer(const std::string &path, const std::string &type);
+  ~Writer();
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void write(const T &value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void write(const std::string &value);
+  template <typename T> void write(const std::vector<T> &values) {
+    write(values.size());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      file.write(reinterpret_cast<const char *>(values.data()),
+                 values.size() * sizeof(T));
+    } else {
+      for (const auto &value : values)
+        write(value);
+    }
+  }
+  template <typename T> void write(const std::set<T> &values) {
+    write(values.size());
+    for (const auto &value : values)
+      write(value);
+  }
+  template <typename K, typename V>
+  void write(const std::map<K, V> &values) {
+    write(values.size());
+    for (const auto &value : values) {
+      write(value.first);
+      write(value.second);
+    }
+  }
+};
+
+// reads what the Writer wrote, in the same order. Throws if the file is not a
+// snapshot of the given type and version, or if it ends early
+class Reader {
+  std::ifstream file;
+  void check();
+
+public:
+  Reader(const std::string &path, const std::string &type);
+  ~Reader();
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void read(T &value) {
+    file.read(reinterpret_cast<char *>(&value), sizeof(T));
+    check();
+  }
+  void read(std::string &value);
+  template <typename T> void read(std::vector<T> &values) {
+    size_t size;
+    read(size);
+    values.resize(size);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      file.read(reinterpret_cast<char *>(values.data()), size * sizeof(T));
+      check();
+    } else {
+      for (auto &value : values)
+        read(value);
+    }
+  }
+  template <typename T> void read(std::set<T> &values) {
+    size_t size;
+    read(size);
+    values.clear();
+    for (auto i = 0; i < size; i++) {
+      T value;
+      read(value);
+      values.insert(value);
+    }
+  }
+  template <typename K, typename V> void read(std::map<K, V> &values) {
+    size_t size;
+    read(size);
+    values.clear();
+    for (auto i = 0; i < size; i++) {
+      K key;
+      read(key);
+      read(values[key]);
+    }
+  }
+  // read a value that is not stored directly in a member
+  template <typename T> T get() {
+    T value;
+    read(value);
+    return value;
+  }
+};
+} // namespace Scenario::Snapshot
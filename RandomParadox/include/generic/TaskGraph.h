@@ -0,0 +1,58 @@
+#pragma once
+#include "generic/Memory.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+namespace Scenario {
+// runs a set of tasks on a pool of worker threads. A task is only started once
+// all tasks it depends on have finished
+class TaskGraph {
+  struct Task {
+    std::string name;
+    std::function<void()> work;
+    std::vector<int> dependants;
+    int openDependencies = 0;
+  };
+  // containers
+  std::vector<Task> tasks;
+  std::deque<int> readyTasks;
+  // vars
+  unsigned int numThreads;
+  int finishedTasks = 0;
+  std::exception_ptr firstError;
+  // allocations of all workers, added to the thread that runs the graph
+  Memory::Allocations workerAllocations{0, 0};
+  // synchronisation of the workers
+  std::mutex taskMutex;
+  std::condition_variable taskCondition;
+  // take ready tasks until all tasks are done or a task failed
+  void work();
+
+public:
+  // 0 uses one worker per hardware thread
+  TaskGraph(const unsigned int numThreads = 0);
+  ~TaskGraph();
+  // add a task, returns the ID other tasks use to depend on it. Dependencies
+  // must have been added before
+  int add(const std::string &name, std::function<void()> work,
+          const std::vector<int> &dependencies = {});
+  // execute all tasks and wait for them. Rethrows the first exception thrown
+  // by a task, after all running tasks have finished. The allocations of the
+  // workers count as allocations of the calling thread
+  void run();
+  // number of ranges parallelFor splits count items into, at least one. Same
+  // meaning of numThreads as for the constructor
+  static int chunkCount(const int count, const unsigned int numThreads);
+  // call work(chunk, first, end) for consecutive ranges of [0, count), each
+  // on its own task, and wait for all of them. With one thread everything
+  // runs on the calling thread
+  static void
+  parallelFor(const std::string &name, const int count,
+              const unsigned int numThreads,
+              const std::function<void(int chunk, int first, int end)> &work);
+};
+} // namespace Scenario
@@ -0,0 +1,43 @@
+#pragma once
+#include "generic/Memory.h"
+#include "utils/Logging.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+namespace Scenario::Tracing {
+// times the enclosing scope and records it as a complete event of the trace,
+// with the memory usage of the process and the allocations made meanwhile by
+// its thread, including those of the TaskGraph workers it waited for.
+// The peak is recorded as the amount the scope raised the peak of the process.
+// Bytes written while it is the innermost scope of its thread are attributed
+// to it, and passed on to the enclosing scope of the same thread at the end
+class ScopedTimer {
+  std::string name;
+  std::chrono::steady_clock::time_point start;
+  Memory::Usage startMemory;
+  Memory::Allocations startAllocations;
+  unsigned long long bytes = 0;
+  ScopedTimer *parent;
+  friend void addBytes(const unsigned long long bytes);
+
+public:
+  ScopedTimer(const std::string &name);
+  ~ScopedTimer();
+};
+// attribute written bytes to the innermost open scope of this thread
+void addBytes(const unsigned long long bytes);
+// attribute the size of a file that was just written
+void addFileBytes(const std::string &path);
+// write all finished scopes as chrome trace event json, which can be viewed
+// in chrome://tracing or ui.perfetto.dev
+void writeTrace(const std::string &path);
+// drop all finished scopes, e.g. after writing the trace of one job
+void clearTrace();
+// the log of fwg isn't synchronised, so everything that may run on a worker
+// thread, like the writers of the game files, logs through logLine instead
+std::mutex &logMutex();
+template <typename... T> void logLine(T &&...args) {
+  std::lock_guard<std::mutex> lock(logMutex());
+  Fwg::Utils::Logging::logLine(std::forward<T>(args)...);
+}
+} // namespace Scenario::Tracing
@@ -20,7 +20,7 @@ public:
     defensive
   };
   Hoi4Country();
-  Hoi4Country(Scenario::PdoxCountry &country, std::vector<Scenario::Region> &gameRegions);
+  Hoi4Country(Scenario::PdoxCountry &country);
   ~Hoi4Country();
   std::string fullName;
   std::string gfxCulture;
@@ -35,7 +35,6 @@ public:
   std::vector<int> units;
   std::vector<int> unitCount;
   std::array<int, 4> parties;
-  std::vector<Region> hoi4Regions;
   std::vector<std::vector<NationalFocus>> foci;
 };
 } // namespace Scenario::Hoi4
\ No newline at end of file
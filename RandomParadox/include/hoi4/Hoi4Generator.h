@@ -31,11 +31,13 @@ class Generator : public Scenario::Generator {
   long long worldPop = 0;
   std::map<std::string, int> totalResources;
   // containers
-  std::set<std::string> majorPowers;
-  std::set<std::string> regionalPowers;
-  std::set<std::string> weakPowers;
+  std::set<CountryId> majorPowers;
+  std::set<CountryId> regionalPowers;
+  std::set<CountryId> weakPowers;
   std::vector<std::string> wargoalsAttack;
   std::vector<std::string> goalsDefence;
+  // the focus chains read from file, shared between all scenarios
+  static std::vector<std::vector<std::vector<std::string>>> focusChains;
   std::map<int, std::string> doctrineMap{
       {0, "blitz"},   {1, "infantry"}, {2, "milita"},  {3, "artillery"},
       {4, "armored"}, {5, "mass"},     {6, "support"}, {7, "defensive"}};
@@ -50,8 +52,11 @@ public:
   // containers
   std::vector<NationalFocus> foci;
   std::vector<NationalFocus> warFoci;
-  std::map<int, std::vector<std::string>> strengthScores;
-  std::map<std::string, Hoi4Country> hoi4Countries;
+  std::map<int, std::vector<CountryId>> strengthScores;
+  // indexed by CountryId
+  std::vector<Hoi4Country> hoi4Countries;
+  // indexed by region ID, countries refer to these through ownedRegions
+  std::vector<Region> hoi4Regions;
   // a list of connections: {sourceHub, destHub, provinces the rails go through}
   std::vector<std::vector<int>> supplyNodeConnections;
   // container holding the resource configurations
@@ -61,7 +66,7 @@ public:
   // member functions
   // constructors/destructors
   Generator();
-  Generator(Fwg::FastWorldGenerator &fwg);
+  Generator(std::shared_ptr<Fwg::FastWorldGenerator> fwg);
   ~Generator();
   // give resources to states
   void generateStateResources();
@@ -74,7 +79,7 @@ public:
   // generate weather per strategic region, from baseprovinces
   void generateWeather();
   // supply hubs and railroads
-  void generateLogistics(Fwg::Gfx::Bitmap countries);
+  void generateLogistics();
   // calculate how strong each country is
   void evaluateCountries();
   bool unitFulfillsRequirements(std::vector<std::string> unitRequirements,
@@ -90,13 +95,16 @@ public:
   // check if a national focus fulfills requirements
   bool stepFulfillsRequirements(
       const std::string stepRequirements,
-      const std::vector<std::set<Hoi4Country>> &stepTargets);
+      const std::vector<std::set<CountryId>> &stepTargets);
   // check if a national focus fulfills requirements
   bool targetFulfillsRequirements(
       const std::string &targetRequirements, const Hoi4Country &source,
       const Hoi4Country &target,
       const std::vector<Scenario::Region> &gameRegions,
-      const std::vector<std::set<std::string>> &levelTargets, const int level);
+      const std::vector<boost::dynamic_bitset<>> &levelTargets,
+      const int level);
+  // read the focus chain files, only the first call does any work
+  static void readFocusChains();
   // evaluate the focus chains for each country
   void evaluateCountryGoals();
   // see which countries are in need of unification
@@ -2,9 +2,11 @@
 #include "FastWorldGenerator.h"
 #include "generic/FormatConverter.h"
 #include "generic/GenericModule.h"
+#include "generic/TaskGraph.h"
 #include "hoi4/Hoi4Generator.h"
 #include "hoi4/Hoi4MapPainting.h"
 #include "hoi4/Hoi4Parsing.h"
+#include "hoi4/Hoi4Snapshot.h"
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <filesystem>
@@ -12,9 +14,25 @@
 namespace Scenario::Hoi4 {
 class Hoi4Module : GenericModule {
   Generator hoi4Gen;
+  std::string configSubFolder;
+  // resources that stay the same for every generated scenario
+  NameGeneration::NameData nameData;
+  Gfx::FormatConverter formatConverter;
+  // save the generated state before writing the files
+  bool saveSnapshots;
+  // where the snapshot is saved and loaded, outside of the mod folder
+  std::string snapshotPath;
+  // owns the provinces of a loaded snapshot
+  std::deque<Fwg::Province> provinceStore;
 
   // clear and create all the mod paths at each run
   bool createPaths();
+  // the fwg settings of the hoi4 config
+  void applyFwgOverrides();
+  // run the world generation and hand the world to a fresh generator
+  void generateWorld();
+  // write all game files from the state of the generator
+  void writeFiles();
   // read the config specific to hoi4
   void readHoiConfig(const std::string &configSubFolder,
                      const std::string &username,
@@ -27,6 +45,13 @@ public:
   ~Hoi4Module();
   // member functions
   void genHoi();
+  // write the game files again from the configured snapshot, without
+  // generating a new world
+  void genHoiFromSnapshot();
+  // generate one scenario per seed, each into its own mod folder
+  void genHoiBatch(const int firstSeed, const int lastSeed);
+  // generate one scenario with the overrides of a daemon job
+  void genHoiJob(const boost::property_tree::ptree &job);
   void mapCountries(bool multiCore);
 };
 } // namespace Scenario::Hoi4
\ No newline at end of file
@@ -7,7 +7,8 @@
 #include "hoi4/Hoi4Generator.h"
 #include <array>
 namespace Scenario::Hoi4::Parsing {
-using hoiMap = std::map<std::string, Hoi4::Hoi4Country>;
+// indexed by CountryId
+using hoiMap = std::vector<Hoi4::Hoi4Country>;
 
 namespace Writing {
 void adj(const std::string &path);
@@ -17,8 +18,7 @@ void buildings(const std::string &path, const std::vector<Fwg::Region> &regions,
                const Fwg::Gfx::Bitmap &heightMap);
 void continents(const std::string &path,
                 const std::vector<Fwg::Continent> &continents);
-void definition(const std::string &path,
-                const std::vector<GameProvince> &provinces);
+void definition(const std::string &path, const ProvinceTable &provinceTable);
 void rocketSites(const std::string &path,
                  const std::vector<Fwg::Region> &regions);
 void strategicRegions(const std::string &path,
@@ -33,19 +33,24 @@ void weatherPositions(const std::string &path,
                       const std::vector<Fwg::Region> &regions,
                       const std::vector<strategicRegion> &strategicRegions);
 // gfx
-void flags(const std::string &path, const hoiMap &countries);
+// the large, medium and small flag of the countries in [first, end)
+void flags(const std::string &path, const Gfx::FlagAtlas &flagAtlas,
+           const hoiMap &countries, const int first, const int end);
 
 // history
-void states(const std::string &path, const hoiMap &countries);
+void states(const std::string &path, const hoiMap &countries,
+            const std::vector<Region> &hoi4Regions,
+            const ProvinceTable &provinceTable);
 void historyCountries(const std::string &path, const hoiMap &countries);
-void historyUnits(const std::string &path, const hoiMap &countries);
+void historyUnits(const std::string &path, const hoiMap &countries,
+                  const std::vector<Region> &hoi4Regions);
 void foci(const std::string &path, const hoiMap &countries,
           const NameGeneration::NameData &nData);
 
 // common
 void commonBookmarks(
     const std::string &path, const hoiMap &countries,
-    const std::map<int, std::vector<std::string>> &strengthScores);
+    const std::map<int, std::vector<CountryId>> &strengthScores);
 void commonCountries(const std::string &path, const std::string &hoiPath,
                      const hoiMap &countries);
 void commonCountryTags(const std::string &path, const hoiMap &countries);
@@ -53,7 +58,8 @@ void commonCountryTags(const std::string &path, const hoiMap &countries);
 // localisation
 void countryNames(const std::string &path, const hoiMap &countries,
                   const NameGeneration::NameData &nData);
-void stateNames(const std::string &path, const hoiMap &countries);
+void stateNames(const std::string &path, const hoiMap &countries,
+                const std::vector<Region> &hoi4Regions);
 void strategicRegionNames(const std::string &path,
                           const std::vector<strategicRegion> &strategicRegions);
 void tutorials(const std::string &path);
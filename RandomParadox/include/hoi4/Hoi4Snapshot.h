@@ -0,0 +1,13 @@
+#pragma once
+#include "generic/Snapshot.h"
+#include "hoi4/Hoi4Generator.h"
+#include <deque>
+namespace Scenario::Hoi4 {
+// store everything the hoi4 writers read, so the files can be written again
+// without generating a new world
+void saveSnapshot(const std::string &path, const Generator &hoi4Gen);
+// restore the state of a generator from a snapshot. The generated provinces
+// are kept in provinceStore, which has to outlive the generator
+void loadSnapshot(const std::string &path, Generator &hoi4Gen,
+                  std::deque<Fwg::Province> &provinceStore);
+} // namespace Scenario::Hoi4
@@ -1,8 +1,12 @@
 #include "FastWorldGenerator.h"
 #include "eu4/Eu4Module.h"
 #include "generic/ScenarioGenerator.h"
+#include "generic/Tracing.h"
 #include "hoi4/Hoi4Module.h"
+#include <cctype>
+#include <chrono>
 #include <filesystem>
+#include <iostream>
 using namespace Fwg;
 void dumpInfo(const std::string &error, const std::string &configSubFolder) {
   std::string dump = "";
@@ -19,6 +23,59 @@ void dumpInfo(const std::string &error, const std::string &configSubFolder) {
   dump += error;
   dump += Utils::Logging::logInstance.getFullLog();
   Scenario::ParserUtils::writeFile("runDump.txt", dump);
+  // stage timings, open in chrome://tracing or ui.perfetto.dev
+  Scenario::Tracing::writeTrace("runTrace.json");
+}
+
+// the log of the generation shares stdout with the job status, clients only
+// parse lines starting with this prefix
+const std::string statusPrefix = "job-status ";
+
+// reads one json job per line from stdin and runs it, until the input ends or a
+// line reads "quit". A status line with the timing and a trace of the stages
+// are written for every job
+void runDaemon(
+    const std::function<void(const boost::property_tree::ptree &)> &runJob) {
+  namespace pt = boost::property_tree;
+  Utils::Logging::logLine("Waiting for jobs");
+  std::string line;
+  auto jobCount = 0;
+  while (std::getline(std::cin, line)) {
+    if (line == "quit")
+      break;
+    if (!line.size())
+      continue;
+    pt::ptree job;
+    pt::ptree status;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      std::stringstream buffer(line);
+      pt::read_json(buffer, job);
+      status.put("id", job.get<std::string>("id", ""));
+      runJob(job);
+      status.put("status", "done");
+    } catch (std::exception e) {
+      status.put("status", "failed");
+      status.put("error", e.what());
+    }
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+    status.put("seconds", duration.count());
+    std::stringstream out;
+    pt::write_json(out, status, false);
+    std::cout << statusPrefix << out.str() << std::flush;
+    // one trace per job, so the events don't pile up while the daemon runs.
+    // The id is used as part of a file name, so keep it to safe characters
+    auto traceName = status.get<std::string>("id", "");
+    if (!traceName.size())
+      traceName = std::to_string(jobCount);
+    for (auto &letter : traceName)
+      if (!std::isalnum((unsigned char)letter) && letter != '-')
+        letter = '_';
+    Scenario::Tracing::writeTrace("runTrace_" + traceName + ".json");
+    Scenario::Tracing::clearTrace();
+    jobCount++;
+  }
 }
 
 int main() {
@@ -43,7 +100,7 @@ int main() {
         "Otherwise try running it through a json validator, e.g. "
         "\"https://jsonlint.com/\" or search for \"json validator\"");
     dumpInfo(e.what(), "");
-    system("pause");
+    Scenario::pause();
     return -1;
   }
   std::string username = metaConf.get<std::string>("config.username");
@@ -68,11 +125,13 @@ int main() {
         "Otherwise try running it through a json validator, e.g. "
         "\"https://jsonlint.com/\" or search for \"json validator\"");
     dumpInfo(e.what(), configSubFolder);
-    system("pause");
+    Scenario::pause();
     return -1;
   }
 
-  bool writeMaps, mapCountries, genHoi4Scenario, genEu4Scenario, multiCore;
+  bool writeMaps, mapCountries, genHoi4Scenario, genEu4Scenario, multiCore,
+      batch, daemon, loadSnapshot;
+  int firstSeed, lastSeed;
   try {
     // if debug is enabled in the config, a directory subtree containing
     // visualisation of many maps will be created
@@ -82,14 +141,24 @@ int main() {
     genHoi4Scenario = rpdConf.get<bool>("randomScenario.genhoi4");
     genEu4Scenario = rpdConf.get<bool>("randomScenario.geneu4");
     multiCore = rpdConf.get<bool>("MappingTool.multiCore");
+    // generate one scenario per seed in the range, in a single run
+    batch = rpdConf.get<bool>("Batch.enabled");
+    firstSeed = rpdConf.get<int>("Batch.firstSeed");
+    lastSeed = rpdConf.get<int>("Batch.lastSeed");
+    // write the hoi4 files from a snapshot instead of generating a world
+    loadSnapshot = rpdConf.get<bool>("Snapshot.load");
+    // keep running and take jobs from stdin
+    daemon = rpdConf.get<bool>("randomScenario.daemon");
   } catch (std::exception e) {
     Utils::Logging::logLine("Error reading boost::property_tree");
     Utils::Logging::logLine(
         "Did you rename a field in the json file?. Error is: ", e.what());
     dumpInfo(e.what(), configSubFolder);
-    system("pause");
+    Scenario::pause();
     return -1;
   }
+  // nobody is there to press a key in unattended runs
+  Scenario::setInteractive(!daemon && !batch);
 
   auto &config = Cfg::Values();
   // check if we can read the config
@@ -103,7 +172,7 @@ int main() {
         "Otherwise try running it through a json validator, e.g. "
         "\"https://jsonlint.com/\" or \"search for json validator\"");
     dumpInfo(e.what(), configSubFolder);
-    system("pause");
+    Scenario::pause();
     return -1;
   }
 
@@ -112,29 +181,56 @@ int main() {
   if (!writeMaps) {
     config.writeMaps = false;
   }
+  if (daemon) {
+    // the module keeps its resources loaded between jobs
+    try {
+      if (genHoi4Scenario) {
+        Scenario::Hoi4::Hoi4Module hoi4Mod(rpdConf, configSubFolder, username,
+                                           false);
+        runDaemon([&](const pt::ptree &job) { hoi4Mod.genHoiJob(job); });
+      } else if (genEu4Scenario) {
+        Scenario::Eu4::Module eu4(rpdConf, configSubFolder, username);
+        runDaemon([&](const pt::ptree &job) { eu4.genEu4Job(job); });
+      }
+    } catch (std::exception e) {
+      Utils::Logging::logLine(e.what());
+      dumpInfo(e.what(), configSubFolder);
+      return -1;
+    }
+    dumpInfo("", configSubFolder);
+    return 0;
+  }
  try {
     if (genHoi4Scenario) {
       // generate hoi4 scenario
       Scenario::Hoi4::Hoi4Module hoi4Mod(rpdConf, configSubFolder, username, mapCountries);
-      if (!mapCountries) {
-        hoi4Mod.genHoi();
-      } else {
+      if (mapCountries) {
         hoi4Mod.mapCountries(multiCore);
+      } else if (loadSnapshot) {
+        hoi4Mod.genHoiFromSnapshot();
+      } else if (batch) {
+        hoi4Mod.genHoiBatch(firstSeed, lastSeed);
+      } else {
+        hoi4Mod.genHoi();
       }
       dumpInfo("", configSubFolder);
-      system("pause");
+      Scenario::pause();
     }
     if (genEu4Scenario) {
       // create eu4module and have it run the scenario generation
       Scenario::Eu4::Module eu4(rpdConf, configSubFolder, username);
-      eu4.genEu4();
+      if (batch) {
+        eu4.genEu4Batch(firstSeed, lastSeed);
+      } else {
+        eu4.genEu4();
+      }
       dumpInfo("", configSubFolder);
-      system("pause");
+      Scenario::pause();
     }
   } catch (std::exception e) {
     Utils::Logging::logLine(e.what());
     dumpInfo(e.what(), configSubFolder);
-    system("pause");
+    Scenario::pause();
     return -1;
   }
   Utils::Logging::logLine("Done with the generation");
@@ -5,8 +5,10 @@ using namespace Fwg::Gfx;
 
 Generator::Generator() {}
 
-Generator::Generator(FastWorldGenerator &fwg) : Scenario::Generator(fwg) {}
+Generator::Generator(std::shared_ptr<FastWorldGenerator> fwg)
+    : Scenario::Generator(fwg) {}
 void Generator::generateRegions(std::vector<Region> &regions) {
+  Tracing::ScopedTimer timer("generateRegions");
   Utils::Logging::logLine("Eu4: Dividing world into strategic regions");
   std::set<int> assignedIdeas;
   for (auto &region : regions) {
@@ -29,22 +31,25 @@ void Generator::generateRegions(std::vector<Region> &regions) {
       eu4regions.push_back(euR);
     }
   }
-  Bitmap eu4RegionBmp(Cfg::Values().width, Cfg::Values().height, 24);
+  Bitmap eu4RegionBmp(labels.width, labels.height, 24);
+  std::vector<Colour> regionColours(regions.size());
   for (auto &strat : eu4regions) {
     Colour c{static_cast<unsigned char>(RandNum::getRandom<unsigned char>() % 255),
         static_cast<unsigned char>(RandNum::getRandom<unsigned char>() % 255),
         static_cast<unsigned char>(RandNum::getRandom<unsigned char>() % 255)};
     for (auto &area : strat.areaIDs) {
       c.setBlue(regions[area].sea ? 255 : 0);
-      for (auto &prov : regions[area].gameProvinces) {
-        for (auto &pix : prov.baseProvince->pixels) {
-          eu4RegionBmp.setColourAtIndex(pix, c);
-        }
-      }
+      regionColours[area] = c;
     }
   }
+  for (auto pix = 0; pix < labels.regions.size(); pix++)
+    if (labels.regions[pix] != LabelRasters::none)
+      eu4RegionBmp.imageData[pix] = regionColours[labels.regions[pix]];
   Bmp::bufferBitmap("eu4regions", eu4RegionBmp);
-  Bmp::save(eu4RegionBmp, "Maps\\eu4Regions.bmp");
+  // only the debug copy on disk is written in the background
+  if (DebugMaps::enabled())
+    DebugMaps::save("Maps\\eu4Regions.bmp",
+                    [eu4RegionBmp] { return eu4RegionBmp; });
 }
 
 } // namespace Scenario::Eu4
\ No newline at end of file
@@ -4,14 +4,14 @@ using namespace Fwg;
 namespace Scenario::Eu4 {
 Module::Module(const boost::property_tree::ptree &gamesConf,
                const std::string &configSubFolder,
-               const std::string &username) {
-  FastWorldGenerator fwg(configSubFolder);
+               const std::string &username)
+    : configSubFolder(configSubFolder) {
   // read eu4 configs and potentially overwrite settings for fwg
   readEu4Config(configSubFolder, username, gamesConf);
-  // now run the world generation
-  fwg.generateWorld();
-  eu4Gen = {fwg};
-  eu4Gen.nData = NameGeneration::prepare("resources\\names", gamePath);
+  // read the static resources once, they are reused for every scenario we
+  // generate
+  nameData = NameGeneration::prepare("resources\\names", gamePath);
+  formatConverter = {gamePath, "Eu4"};
 }
 
 Module::~Module() {}
@@ -72,30 +72,60 @@ void Module::readEu4Config(const std::string &configSubFolder,
     Utils::Logging::logLine(
         "Otherwise try running it through a json validator, e.g. "
         "\"https://jsonlint.com/\" or search for \"json validator\"");
-    system("pause");
+    Scenario::pause();
   }
   //  passed to generic ScenarioGenerator
   numCountries = eu4Conf.get<int>("scenario.numCountries");
-  config.seaLevel = 95;
-  config.seaProvFactor *= 0.7;
-  config.landProvFactor *= 0.7;
-  config.loadMapsPath = eu4Conf.get<std::string>("fastworldgen.loadMapsPath");
-  config.heightmapIn = config.loadMapsPath +
-                       eu4Conf.get<std::string>("fastworldgen.heightMapName");
+  regionsPerCountry = eu4Conf.get<int>("scenario.regionsPerCountry", 6);
+  seaProvFactor = config.seaProvFactor * 0.7;
+  landProvFactor = config.landProvFactor * 0.7;
+  loadMapsPath = eu4Conf.get<std::string>("fastworldgen.loadMapsPath");
+  heightmapIn =
+      loadMapsPath + eu4Conf.get<std::string>("fastworldgen.heightMapName");
+  applyFwgOverrides();
   cut = config.cut;
+  numThreads = rpdConf.get<unsigned int>("randomScenario.numThreads");
   // check if config settings are fine
   config.sanityCheck();
 }
 
+void Module::applyFwgOverrides() {
+  auto &config = Cfg::Values();
+  config.seaLevel = 95;
+  config.seaProvFactor = seaProvFactor;
+  config.landProvFactor = landProvFactor;
+  config.loadMapsPath = loadMapsPath;
+  config.heightmapIn = heightmapIn;
+}
+
+void Module::generateWorld() {
+  Tracing::ScopedTimer timer("fwg::generateWorld");
+  // constructing the world generator reads its config again, keep the
+  // settings of this run and apply them on top
+  const auto seed = Cfg::Values().seed;
+  const auto writeMaps = Cfg::Values().writeMaps;
+  // the generator takes over the world instead of copying all of its maps
+  auto fwg = std::make_shared<FastWorldGenerator>(configSubFolder);
+  applyFwgOverrides();
+  applyRunSettings(seed, writeMaps);
+  fwg->generateWorld();
+  eu4Gen = {fwg};
+  eu4Gen.numThreads = numThreads;
+  // copy, as the generation of tags modifies the name data
+  eu4Gen.nData = nameData;
+}
+
 void Module::genEu4() {
+  Tracing::ScopedTimer timer("genEu4");
   if (!createPaths())
     return;
 
   try {
+    generateWorld();
     // start with the generic stuff in the Scenario Generator
     eu4Gen.mapRegions();
     eu4Gen.mapContinents();
-    eu4Gen.generateCountries(numCountries, gamePath);
+    eu4Gen.generateCountries(numCountries, regionsPerCountry, gamePath);
     eu4Gen.evaluateNeighbours();
     eu4Gen.generateWorld();
     eu4Gen.dumpDebugCountrymap(Cfg::Values().mapsPath + "countries.bmp");
@@ -109,77 +139,128 @@ void Module::genEu4() {
   try {
     // generate map files. Format must be converted and colours mapped to eu4
     // compatible colours
-    Gfx::FormatConverter formatConverter(gamePath, "Eu4");
-    formatConverter.dump8BitTerrain(eu4Gen.fwg.climateMap,
-                                    gameModPath + "\\map\\terrain.bmp",
-                                    "terrain", cut);
-    formatConverter.dump8BitRivers(
-        eu4Gen.fwg.riverMap, gameModPath + "\\map\\rivers.bmp", "rivers", cut);
-    formatConverter.dump8BitTrees(eu4Gen.fwg.climateMap, eu4Gen.fwg.treeMap,
-                                  gameModPath + "\\map\\trees.bmp", "trees",
-                                  false);
-    formatConverter.dump8BitHeightmap(eu4Gen.fwg.heightMap,
-                                      gameModPath + "\\map\\heightmap.bmp",
-                                      "heightmap");
-    formatConverter.dumpTerrainColourmap(
-        eu4Gen.fwg.springMap, eu4Gen.fwg.cityMap, gameModPath,
-        "\\map\\terrain\\colormap_spring.dds", DXGI_FORMAT_B8G8R8A8_UNORM, cut);
-    formatConverter.dumpTerrainColourmap(
-        eu4Gen.fwg.summerMap, eu4Gen.fwg.cityMap, gameModPath,
-        "\\map\\terrain\\colormap_summer.dds", DXGI_FORMAT_B8G8R8A8_UNORM, cut);
-    formatConverter.dumpTerrainColourmap(
-        eu4Gen.fwg.autumnMap, eu4Gen.fwg.cityMap, gameModPath,
-        "\\map\\terrain\\colormap_autumn.dds", DXGI_FORMAT_B8G8R8A8_UNORM, cut);
-    formatConverter.dumpTerrainColourmap(
-        eu4Gen.fwg.winterMap, eu4Gen.fwg.cityMap, gameModPath,
-        "\\map\\terrain\\colormap_winter.dds", DXGI_FORMAT_B8G8R8A8_UNORM, cut);
-    formatConverter.dumpDDSFiles(eu4Gen.fwg.riverMap, eu4Gen.fwg.heightMap,
-                                 gameModPath + "\\map\\terrain\\colormap_water",
-                                 cut, 2);
-    formatConverter.dumpWorldNormal(
-        eu4Gen.fwg.sobelMap, gameModPath + "\\map\\world_normal.bmp", cut);
+    // all writers only read the generated state and write to their own
+    // files, so none of them has to wait for another
+    TaskGraph writers(numThreads);
+    writers.add("terrain", [&] {
+      formatConverter.dump8BitTerrain(eu4Gen.fwg->climateMap,
+                                      gameModPath + "\\map\\terrain.bmp",
+                                      "terrain", cut);
+    });
+    writers.add("rivers", [&] {
+      formatConverter.dump8BitRivers(eu4Gen.fwg->riverMap,
+                                     gameModPath + "\\map\\rivers.bmp",
+                                     "rivers", cut);
+    });
+    writers.add("trees", [&] {
+      formatConverter.dump8BitTrees(eu4Gen.fwg->climateMap, eu4Gen.fwg->treeMap,
+                                    gameModPath + "\\map\\trees.bmp", "trees",
+                                    false);
+    });
+    writers.add("heightmap", [&] {
+      formatConverter.dump8BitHeightmap(eu4Gen.fwg->heightMap,
+                                        gameModPath + "\\map\\heightmap.bmp",
+                                        "heightmap");
+    });
+    // one encode per season
+    const std::vector<std::pair<const Fwg::Gfx::Bitmap &, std::string>>
+        seasons{{eu4Gen.fwg->springMap, "spring"},
+                {eu4Gen.fwg->summerMap, "summer"},
+                {eu4Gen.fwg->autumnMap, "autumn"},
+                {eu4Gen.fwg->winterMap, "winter"}};
+    for (const auto &season : seasons) {
+      writers.add("colourmap_" + season.second, [&] {
+        formatConverter.dumpTerrainColourmap(
+            season.first, eu4Gen.fwg->cityMap, gameModPath,
+            "\\map\\terrain\\colormap_" + season.second + ".dds",
+            DXGI_FORMAT_B8G8R8A8_UNORM, cut);
+      });
+    }
+    writers.add("waterColourmap", [&] {
+      formatConverter.dumpDDSFiles(
+          eu4Gen.fwg->riverMap, eu4Gen.fwg->heightMap,
+          gameModPath + "\\map\\terrain\\colormap_water", cut, 2);
+    });
+    writers.add("worldNormal", [&] {
+      formatConverter.dumpWorldNormal(
+          eu4Gen.fwg->sobelMap, gameModPath + "\\map\\world_normal.bmp", cut);
+    });
 
     using namespace Fwg::Gfx;
     // just copy over provinces.bmp, already in a compatible format
-    Bmp::save(eu4Gen.fwg.provinceMap, gameModPath + "\\map\\provinces.bmp");
-    {
-      using namespace Parsing;
-      // now do text
-      writeAdj(gameModPath + "\\map\\adjacencies.csv", eu4Gen.gameProvinces);
+    writers.add("provinces", [&] {
+      Bmp::save(eu4Gen.fwg->provinceMap, gameModPath + "\\map\\provinces.bmp");
+      Tracing::addFileBytes(gameModPath + "\\map\\provinces.bmp");
+    });
+    // now do text
+    using namespace Parsing;
+    const auto &gameProvinces = eu4Gen.gameProvinces;
+    const auto &gameRegions = eu4Gen.gameRegions;
+    const auto eu4Regions = eu4Gen.getEu4Regions();
+    writers.add("adjacencies", [&] {
+      writeAdj(gameModPath + "\\map\\adjacencies.csv", gameProvinces);
+    });
+    writers.add("ambientObjects", [&] {
       writeAmbientObjects(gameModPath + "\\map\\ambient_object.txt",
-                          eu4Gen.gameProvinces);
-      writeAreas(gameModPath + "\\map\\area.txt", eu4Gen.gameRegions, gamePath);
+                          gameProvinces);
+    });
+    writers.add("areas", [&] {
+      writeAreas(gameModPath + "\\map\\area.txt", gameRegions, gamePath);
+    });
+    writers.add("colonialRegions", [&] {
       writeColonialRegions(
           gameModPath + "\\common\\colonial_regions\\00_colonial_regions.txt",
-          gamePath, eu4Gen.gameProvinces);
-      writeClimate(gameModPath + "\\map\\climate.txt", eu4Gen.gameProvinces);
-      writeContinent(gameModPath + "\\map\\continent.txt",
-                     eu4Gen.gameProvinces);
-      writeDefaultMap(gameModPath + "\\map\\default.map", eu4Gen.gameProvinces);
-      writeDefinition(gameModPath + "\\map\\definition.csv",
-                      eu4Gen.gameProvinces);
-      writePositions(gameModPath + "\\map\\positions.txt",
-                     eu4Gen.gameProvinces);
-      writeRegions(gameModPath + "\\map\\region.txt", gamePath,
-                   eu4Gen.getEu4Regions());
+          gamePath, gameProvinces);
+    });
+    writers.add("climate", [&] {
+      writeClimate(gameModPath + "\\map\\climate.txt", eu4Gen.provinceTable);
+    });
+    writers.add("continent", [&] {
+      writeContinent(gameModPath + "\\map\\continent.txt", gameProvinces);
+    });
+    writers.add("defaultMap", [&] {
+      writeDefaultMap(gameModPath + "\\map\\default.map", gameProvinces);
+    });
+    writers.add("definition", [&] {
+      writeDefinition(gameModPath + "\\map\\definition.csv", gameProvinces);
+    });
+    writers.add("positions", [&] {
+      writePositions(gameModPath + "\\map\\positions.txt", gameProvinces);
+    });
+    writers.add("regions", [&] {
+      writeRegions(gameModPath + "\\map\\region.txt", gamePath, eu4Regions);
+    });
+    writers.add("superregion", [&] {
       writeSuperregion(gameModPath + "\\map\\superregion.txt", gamePath,
-                       eu4Gen.gameRegions);
-      writeTerrain(gameModPath + "\\map\\terrain.txt", eu4Gen.gameProvinces);
+                       gameRegions);
+    });
+    writers.add("terrainTxt", [&] {
+      writeTerrain(gameModPath + "\\map\\terrain.txt", gameProvinces);
+    });
+    writers.add("tradeCompanies", [&] {
       writeTradeCompanies(
           gameModPath + "\\common\\trade_companies\\00_trade_companies.txt",
-          gamePath, eu4Gen.gameProvinces);
-      writeTradewinds(gameModPath + "\\map\\trade_winds.txt",
-                      eu4Gen.gameProvinces);
-
+          gamePath, gameProvinces);
+    });
+    writers.add("tradewinds", [&] {
+      writeTradewinds(gameModPath + "\\map\\trade_winds.txt", gameProvinces);
+    });
+    writers.add("descriptor", [&] {
       copyDescriptorFile("resources\\eu4\\descriptor.mod", gameModPath,
                          gameModsDirectory, modName);
-
-      writeProvinces(gameModPath + "\\history\\provinces\\",
-                     eu4Gen.gameProvinces, eu4Gen.gameRegions);
-      writeLoc(gameModPath + "\\localisation\\", gamePath, eu4Gen.gameRegions,
-               eu4Gen.gameProvinces, eu4Gen.getEu4Regions());
-    }
-
+    });
+    writers.add("provinceHistory", [&] {
+      writeProvinces(gameModPath + "\\history\\provinces\\", gameProvinces,
+                     eu4Gen.provinceTable, gameRegions);
+    });
+    writers.add("localisation", [&] {
+      writeLoc(gameModPath + "\\localisation\\", gamePath, gameRegions,
+               gameProvinces, eu4Regions);
+    });
+    Tracing::ScopedTimer writeTimer("writeFiles");
+    writers.run();
+    // the debug maps of the generation were written meanwhile
+    DebugMaps::flush();
   } catch (std::exception e) {
     std::string error = "Error while dumping and writing files.\n";
     error += "Error is: \n";
@@ -188,4 +269,17 @@ void Module::genEu4() {
   }
 }
 
+void Module::genEu4Batch(const int firstSeed, const int lastSeed) {
+  for (auto seed = firstSeed; seed <= lastSeed; seed++) {
+    Utils::Logging::logLine("EU4: Generating scenario for seed ", seed);
+    boost::property_tree::ptree job;
+    job.put("seed", seed);
+    runJob(job, [this] { genEu4(); });
+  }
+}
+
+void Module::genEu4Job(const boost::property_tree::ptree &job) {
+  runJob(job, [this] { genEu4(); });
+}
+
 } // namespace Scenario::Eu4
\ No newline at end of file
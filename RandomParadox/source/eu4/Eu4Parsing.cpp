@@ -1,4 +1,5 @@
 #include "eu4/Eu4Parsing.h"
+#include "generic/Tracing.h"
 using namespace Fwg;
 namespace pU = Scenario::ParserUtils;
 namespace Scenario::Eu4::Parsing {
@@ -23,7 +24,7 @@ std::string loadVanillaFile(const std::string &path,
 }
 void writeAdj(const std::string &path,
               const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Adjacencies");
+  Tracing::logLine("EU4 Parser: Map: Writing Adjacencies");
   // From;To;Type;Through;start_x;start_y;stop_x;stop_y;adjacency_rule_name;Comment
   // empty file for now
   std::string content;
@@ -45,7 +46,7 @@ void writeAdj(const std::string &path,
 
 void writeAmbientObjects(const std::string &path,
                          const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("Eu4 Parser: Map: Writing Ambient Objects");
+  Tracing::logLine("Eu4 Parser: Map: Writing Ambient Objects");
   // empty file for now
   std::string content{""};
   pU::writeFile(path, content);
@@ -53,7 +54,7 @@ void writeAmbientObjects(const std::string &path,
 
 void writeAreas(const std::string &path, const std::vector<Region> &regions,
                 const std::string &gamePath) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Areas");
+  Tracing::logLine("EU4 Parser: Map: Writing Areas");
   std::string content =
       loadVanillaFile(gamePath + "\\map\\area.txt", {"{", "}", "_area"});
   const auto templateArea = pU::readFile("resources\\eu4\\map\\area.txt");
@@ -74,8 +75,8 @@ void writeAreas(const std::string &path, const std::vector<Region> &regions,
 }
 
 void writeClimate(const std::string &path,
-                  const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing climate");
+                  const ProvinceTable &provinceTable) {
+  Tracing::logLine("EU4 Parser: Map: Writing climate");
   /* climate types:
    * tropical, arid, arctic, mild_winter, normal_winter, severe_winter,
    * impassable, mild_monsoon, normal_monsoon, severe_monsoon
@@ -92,12 +93,13 @@ void writeClimate(const std::string &path,
   std::string normal_monsoon{""};
   std::string severe_monsoon{""};
 
-  for (const auto &province : provinces) {
-    const auto provID = std::to_string(province.ID + 1);
+  for (auto ID = 0; ID < provinceTable.size(); ID++) {
+    const auto provID = std::to_string(ID + 1);
+    const auto &terrainType = provinceTable.terrainType(ID);
     auto minTemp = 400.0;
     auto maxTemp = -200.0;
     auto maxPrecipitation = 0.0;
-    for (const auto &temp : province.baseProvince->weatherMonths) {
+    for (const auto &temp : provinceTable.baseProvinces[ID]->weatherMonths) {
       // find min and max temperatures
       Utils::switchIfComparator(temp[1], minTemp, std::less());
       Utils::switchIfComparator(temp[1], maxTemp, std::greater());
@@ -112,12 +114,12 @@ void writeClimate(const std::string &path,
 
     if (minTemp < 0.1 && maxTemp < 0.4)
       arctic.append(provID + " ");
-    if (province.terrainType == "mountains")
+    if (terrainType == "mountains")
       impassable.append(provID + " ");
 
-    if (province.terrainType == "jungle")
+    if (terrainType == "jungle")
       tropical.append(provID + " ");
-    if (province.terrainType == "desert")
+    if (terrainType == "desert")
       arid.append(provID + " ");
     else if (maxTemp > 0.80 && maxPrecipitation < 0.5)
       arid.append(provID + " ");
@@ -159,7 +161,7 @@ void writeColonialRegions(const std::string &path, const std::string &gamePath,
 void writeContinent(const std::string &path,
                     const std::vector<GameProvince> &provinces) {
 
-  Utils::Logging::logLine("EU4 Parser: Map: Writing continents");
+  Tracing::logLine("EU4 Parser: Map: Writing continents");
   auto content = pU::readFile("resources\\eu4\\map\\continent.txt");
   // must not be more than 6 continents!
   std::array<std::vector<int>, 6> continentMap;
@@ -183,7 +185,7 @@ void writeContinent(const std::string &path,
 }
 void writeDefaultMap(const std::string &path,
                      const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing default map");
+  Tracing::logLine("EU4 Parser: Map: Writing default map");
   auto content = pU::readFile("resources\\eu4\\map\\default.map");
   pU::replaceOccurences(content, "templateWidth",
                         std::to_string(Cfg::Values().width));
@@ -211,7 +213,7 @@ void writeDefaultMap(const std::string &path,
 
 void writeDefinition(const std::string &path,
                      const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Defining Provinces");
+  Tracing::logLine("EU4 Parser: Map: Defining Provinces");
   std::string content{"province;red;green;blue;x;x\n"};
   for (const auto &prov : provinces) {
     std::vector<std::string> arguments{
@@ -228,7 +230,7 @@ void writeDefinition(const std::string &path,
 
 void writePositions(const std::string &path,
                     const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Positions");
+  Tracing::logLine("EU4 Parser: Map: Writing Positions");
 
   /* for positions, rotation and height, order is:
    * city model (xy position, rotation, height),
@@ -264,7 +266,7 @@ void writePositions(const std::string &path,
 
 void writeRegions(const std::string &path, const std::string &gamePath,
                   const std::vector<eu4Region> &eu4regions) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Regions");
+  Tracing::logLine("EU4 Parser: Map: Writing Regions");
   std::string content =
       loadVanillaFile(gamePath + "\\map\\region.txt", {"{", "}", "areas"});
   while (pU::removeBracketBlockFromKey(content, "monsoon")) {
@@ -286,7 +288,7 @@ void writeRegions(const std::string &path, const std::string &gamePath,
 
 void writeSuperregion(const std::string &path, const std::string &gamePath,
                       const std::vector<Region> &regions) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Superregions");
+  Tracing::logLine("EU4 Parser: Map: Writing Superregions");
   // not really necessary
 
   std::string content = loadVanillaFile(gamePath + "\\map\\superregion.txt",
@@ -296,7 +298,7 @@ void writeSuperregion(const std::string &path, const std::string &gamePath,
 
 void writeTerrain(const std::string &path,
                   const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Terrain");
+  Tracing::logLine("EU4 Parser: Map: Writing Terrain");
   // copying for now, as overwrites of terrain type are not a necessity
   pU::writeFile(path, pU::readFile("resources\\eu4\\map\\terrain.txt"));
 }
@@ -316,7 +318,7 @@ void writeTradeCompanies(const std::string &path, const std::string &gamePath,
 
 void writeTradewinds(const std::string &path,
                      const std::vector<GameProvince> &provinces) {
-  Utils::Logging::logLine("EU4 Parser: Map: Writing Tradewinds");
+  Tracing::logLine("EU4 Parser: Map: Writing Tradewinds");
   // empty for now, as tradewinds are not a necessity
   pU::writeFile(path, pU::readFile("resources\\eu4\\map\\trade_winds.txt"));
 }
@@ -325,7 +327,7 @@ void copyDescriptorFile(const std::string &sourcePath,
                         const std::string &destPath,
                         const std::string &modsDirectory,
                         const std::string &modName) {
-  Utils::Logging::logLine("EU4 Parser: Copying Descriptor file");
+  Tracing::logLine("EU4 Parser: Copying Descriptor file");
   auto descriptorText = pU::readFile(sourcePath);
   pU::replaceOccurences(descriptorText, "templateName", modName);
   auto modText{descriptorText};
@@ -338,18 +340,19 @@ void copyDescriptorFile(const std::string &sourcePath,
 
 void writeProvinces(const std::string &path,
                     const std::vector<GameProvince> &provinces,
+                    const ProvinceTable &provinceTable,
                     const std::vector<Region> &regions) {
-  Utils::Logging::logLine("Eu4 Parser: History: Drawing Province Borders");
+  Tracing::logLine("Eu4 Parser: History: Drawing Province Borders");
   auto templateContent =
       pU::readFile("resources\\eu4\\history\\provinceTemplate.txt");
   for (const auto &region : regions) {
-    for (const auto &prov : region.gameProvinces) {
+    for (const auto &prov : region.provinces) {
       // make sure lakes and wastelands are empty
-      if (prov.baseProvince->isLake || prov.terrainType == "mountains") {
-        pU::writeFile(path + "\\" + std::to_string(prov.ID + 1) + "-a.txt", "");
+      if (prov->isLake || provinceTable.terrainType(prov->ID) == "mountains") {
+        pU::writeFile(path + "\\" + std::to_string(prov->ID + 1) + "-a.txt", "");
       } else {
         std::string content{templateContent};
-        pU::writeFile(path + "\\" + std::to_string(prov.ID + 1) + "-a.txt",
+        pU::writeFile(path + "\\" + std::to_string(prov->ID + 1) + "-a.txt",
                       content);
       }
     }
@@ -361,7 +364,7 @@ void writeLoc(const std::string &path, const std::string &gamePath,
               const std::vector<GameProvince> &provinces,
               const std::vector<eu4Region> &eu4regions) {
 
-  Utils::Logging::logLine("Eu4 Parser: Localisation: Writing Area Names");
+  Tracing::logLine("Eu4 Parser: Localisation: Writing Area Names");
   std::vector<std::string> locKeys{"l_english", "l_german", "l_french",
                                    "l_spanish"};
   for (const auto &locKey : locKeys) {
@@ -0,0 +1,54 @@
+#include "generic/CountryAdjacency.h"
+namespace Scenario {
+CountryAdjacency::CountryAdjacency() {}
+
+CountryAdjacency::~CountryAdjacency() {}
+
+void CountryAdjacency::addBorders(const CountryId first,
+                                  const CountryId second, const int count) {
+  auto &borders = borderCounts[first * countryCount + second];
+  borders += count;
+  borderCounts[second * countryCount + first] = borders;
+  rows[first][second] = borders > 0;
+  rows[second][first] = borders > 0;
+}
+
+void CountryAdjacency::reset(const int countryCount) {
+  this->countryCount = countryCount;
+  borderCounts.assign((size_t)countryCount * countryCount, 0);
+  rows.assign(countryCount, boost::dynamic_bitset<>(countryCount));
+}
+
+void CountryAdjacency::changeOwner(const std::vector<Region> &gameRegions,
+                                   const Region &region,
+                                   const CountryId previousOwner) {
+  if (previousOwner == region.owner)
+    return;
+  for (const auto neighbourID : region.neighbours) {
+    if (neighbourID == region.ID)
+      continue;
+    const auto owner = gameRegions[neighbourID].owner;
+    if (owner == -1)
+      continue;
+    if (previousOwner != -1 && owner != previousOwner)
+      addBorders(previousOwner, owner, -1);
+    if (region.owner != -1 && owner != region.owner)
+      addBorders(region.owner, owner, 1);
+  }
+}
+
+bool CountryAdjacency::neighbours(const CountryId first,
+                                  const CountryId second) const {
+  return rows[first].test(second);
+}
+
+int CountryAdjacency::borderCount(const CountryId first,
+                                  const CountryId second) const {
+  return borderCounts[first * countryCount + second];
+}
+
+const boost::dynamic_bitset<> &
+CountryAdjacency::row(const CountryId country) const {
+  return rows[country];
+}
+} // namespace Scenario
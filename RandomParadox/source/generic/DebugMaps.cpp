@@ -0,0 +1,37 @@
+#include "generic/DebugMaps.h"
+#include "generic/Tracing.h"
+#include <future>
+#include <mutex>
+namespace Scenario::DebugMaps {
+static std::mutex queueMutex;
+// the last queued map, each map waits for the one queued before it
+static std::future<void> lastMap;
+
+bool enabled() { return Fwg::Cfg::Values().writeMaps; }
+
+void save(const std::string &path,
+          std::function<Fwg::Gfx::Bitmap()> render) {
+  if (!enabled())
+    return;
+  std::lock_guard<std::mutex> lock(queueMutex);
+  auto write = [path, render = std::move(render),
+                previous = std::move(lastMap)]() mutable {
+    if (previous.valid())
+      previous.get();
+    Tracing::ScopedTimer timer("debugMap " + path);
+    Fwg::Gfx::Bmp::save(render(), path.c_str());
+    Tracing::addFileBytes(path);
+  };
+  lastMap = std::async(std::launch::async, std::move(write));
+}
+
+void flush() {
+  std::future<void> map;
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    map = std::move(lastMap);
+  }
+  if (map.valid())
+    map.get();
+}
+} // namespace Scenario::DebugMaps
@@ -1,7 +1,12 @@
 #include "generic/Flag.h"
+#include <array>
+#include <cstring>
 
 namespace Scenario::Gfx {
 using namespace Fwg;
+// bytes per row of a flag and of a symbol template
+static const int lineSize = 328;
+static const int symbolLineSize = 52 * 4;
 namespace PU = Scenario::ParserUtils;
 std::map<std::string, std::vector<Fwg::Gfx::Colour>> Flag::colourGroups;
 std::vector<std::vector<std::vector<int>>> Flag::flagTypes(7);
@@ -10,77 +15,78 @@ std::vector<std::vector<uint8_t>> Flag::flagTemplates;
 std::vector<std::vector<uint8_t>> Flag::symbolTemplates;
 std::vector<FlagInfo> Flag::flagMetadata;
 std::vector<SymbolInfo> Flag::symbolMetadata;
+std::vector<PaletteTemplate> Flag::flagPalettes;
+std::vector<PaletteTemplate> Flag::symbolPalettes;
+std::vector<SymbolPlacement> Flag::symbolPlacements;
+bool Flag::resourcesLoaded = false;
 Flag::Flag() {}
 
-Flag::Flag(const int width, const int height) : width(width), height(height) {
-  image = std::vector<unsigned char>(width * height * 4, 0);
-  auto randomIndex = RandNum::getRandom(flagTemplates.size());
+Flag::Flag(const int width, const int height, RandomStream &random)
+    : width(width), height(height) {
+  auto randomIndex = random.getRandom(0, (int)flagTemplates.size() - 1);
   image = flagTemplates[randomIndex];
   const auto &flagInfo = flagMetadata[randomIndex];
-  // get the template and map all colours to indices
-  std::map<Fwg::Gfx::Colour, std::vector<int>> colourMapping;
-  for (auto i = 0; i < image.size(); i += 4) {
-    Fwg::Gfx::Colour temp(image[i], image[i + 1], image[i + 2]);
-    colourMapping[temp].push_back(i);
-  }
+  const auto &flagPalette = flagPalettes[randomIndex];
+  const auto &placement = symbolPlacements[randomIndex];
   // determine replacements for the colours in the template.
   // pool of colours is taken from colour groups defined in metadata files
-  std::vector<Fwg::Gfx::Colour> replacementColours;
+  std::vector<std::array<uint8_t, 4>> replacementColours;
   for (auto &colGroup : flagInfo.flagColourGroups) {
-    const auto &colour = Utils::selectRandom(colourGroups[colGroup]);
-    replacementColours.push_back(colour);
+    const auto &colour = random.selectRandom(colourGroups.at(colGroup));
+    replacementColours.push_back(
+        {colour.getBGR()[0], colour.getBGR()[1], colour.getBGR()[2], 255});
   }
-
-  // now convert the old colours to the replacement colours
-  // alpha values stay the same
-  int colIndex = 0;
-  for (const auto &mapping : colourMapping) {
-    for (auto index : mapping.second)
-      setPixel(replacementColours[colIndex], index);
-    colIndex++;
+  // now convert the template colours to the replacement colours. Per palette
+  // ID the bits kept from the template and the bits replaced, so the loop has
+  // no branch. Colours without a replacement keep all of their bits
+  std::array<std::uint32_t, 256> keptBits;
+  std::array<std::uint32_t, 256> replacedBits;
+  keptBits.fill(~0u);
+  replacedBits.fill(0);
+  for (auto i = 0; i < std::min<size_t>(replacementColours.size(), 256); i++) {
+    keptBits[i] = 0;
+    std::memcpy(&replacedBits[i], replacementColours[i].data(), 4);
+  }
+  const auto paletteIDs = flagPalette.paletteIDs.data();
+  const auto pixels = std::min(image.size() / 4, flagPalette.paletteIDs.size());
+  for (auto pixel = 0; pixel < pixels; pixel++) {
+    std::uint32_t value;
+    std::memcpy(&value, &image[pixel * 4], 4);
+    value = (value & keptBits[paletteIDs[pixel]]) |
+            replacedBits[paletteIDs[pixel]];
+    std::memcpy(&image[pixel * 4], &value, 4);
   }
   // now load symbol templates
-  randomIndex = RandNum::getRandom(symbolTemplates.size());
-  auto symbol{symbolTemplates[randomIndex]};
-  auto symbolInfo{symbolMetadata[randomIndex]};
-
-  // now resize symbol
-  int newSize = 52 * flagInfo.reductionFactor;
-  symbol = Flag::resize(newSize, newSize, symbol, 52, 52);
+  randomIndex = random.getRandom(0, (int)symbolTemplates.size() - 1);
+  const auto &symbolPalette = symbolPalettes[randomIndex];
 
   replacementColours.clear();
   for (const auto &colGroup : flagInfo.symbolColourGroups) {
-    const auto &colour =
-        colourGroups[colGroup]
-                    [RandNum::getRandom(colourGroups[colGroup].size())];
-    replacementColours.push_back(colour);
+    const auto &colour = random.selectRandom(colourGroups.at(colGroup));
+    replacementColours.push_back(
+        {colour.getBGR()[0], colour.getBGR()[1], colour.getBGR()[2], 255});
   }
-  // get the template and map all colours to indices
-  colourMapping.clear();
-  for (auto i = 0; i < symbol.size(); i += 4) {
-    Fwg::Gfx::Colour temp(symbol[i], symbol[i + 1], symbol[i + 2]);
-    // only if alpha is greater 0
-    if (symbol[i + 3] > 0)
-      colourMapping[temp].push_back(i);
+  // colours can get lost when scaling down, the remaining ones take their
+  // ranks among themselves
+  std::vector<int> symbolIDs(symbolPalette.paletteSize, -1);
+  for (const auto source : placement.sources) {
+    const auto paletteID = symbolPalette.paletteIDs[source];
+    if (paletteID != PaletteTemplate::transparent)
+      symbolIDs[paletteID] = 0;
   }
-  colIndex = 0;
-  const int lineSize = 328;
-  const int symbolLineSize = 52 * 4;
-  for (const auto &mapping : colourMapping) {
-    for (auto index : mapping.second) {
-      // map index from normal flag size to symbol size
-      auto offset = (int)(flagInfo.symbolHeightOffset * 52);
-      offset -= offset % 4;
-      auto height =
-          offset + (index / (int)(symbolLineSize * flagInfo.reductionFactor));
-      offset = (int)((flagInfo.symbolWidthOffset * lineSize));
-      offset -= offset % 4;
-      auto width = offset + (index % (int)(52 * flagInfo.reductionFactor * 4));
-      setPixel(replacementColours[colIndex], lineSize * height + width);
-    }
-    colIndex++;
+  auto rank = 0;
+  for (auto &symbolID : symbolIDs)
+    if (symbolID != -1)
+      symbolID = rank++;
+  for (auto i = 0; i < placement.sources.size(); i++) {
+    const auto paletteID = symbolPalette.paletteIDs[placement.sources[i]];
+    if (paletteID == PaletteTemplate::transparent ||
+        symbolIDs[paletteID] >= replacementColours.size() ||
+        placement.targets[i] == -1)
+      continue;
+    std::memcpy(&image[placement.targets[i]],
+                replacementColours[symbolIDs[paletteID]].data(), 4);
   }
-  return;
 }
 
 Flag::~Flag() {}
@@ -135,6 +141,65 @@ std::vector<uint8_t> Flag::resize(const int width, const int height,
   return resized;
 }
 
+PaletteTemplate Flag::compileTemplate(const std::vector<uint8_t> &image,
+                                      const bool skipTransparent) {
+  std::map<Fwg::Gfx::Colour, int> paletteIDs;
+  for (auto i = 0; i < image.size(); i += 4)
+    if (!skipTransparent || image[i + 3] > 0)
+      paletteIDs[{image[i], image[i + 1], image[i + 2]}];
+  if (paletteIDs.size() >= PaletteTemplate::transparent)
+    throw(std::exception("Flag template has too many colours"));
+  PaletteTemplate palette{{}, (int)paletteIDs.size()};
+  auto paletteID = 0;
+  for (auto &mapping : paletteIDs)
+    mapping.second = paletteID++;
+  palette.paletteIDs.reserve(image.size() / 4);
+  for (auto i = 0; i < image.size(); i += 4)
+    palette.paletteIDs.push_back(
+        skipTransparent && !image[i + 3]
+            ? PaletteTemplate::transparent
+            : (uint8_t)paletteIDs.at({image[i], image[i + 1], image[i + 2]}));
+  return palette;
+}
+
+SymbolPlacement Flag::placeSymbol(const FlagInfo &flagInfo,
+                                  const int imageSize) {
+  SymbolPlacement placement;
+  // the symbol is scaled down by sampling every factor-th pixel
+  const int newSize = 52 * flagInfo.reductionFactor;
+  const auto factor = 52 / newSize;
+  auto heightOffset = (int)(flagInfo.symbolHeightOffset * 52);
+  heightOffset -= heightOffset % 4;
+  auto widthOffset = (int)((flagInfo.symbolWidthOffset * lineSize));
+  widthOffset -= widthOffset % 4;
+  const auto rowLength = (int)(symbolLineSize * flagInfo.reductionFactor);
+  const auto columnLength = (int)(52 * flagInfo.reductionFactor * 4);
+  for (auto h = 0; h < newSize; h++) {
+    for (auto w = 0; w < newSize; w++) {
+      placement.sources.push_back(factor * h * 52 + factor * w);
+      // map index from symbol size to normal flag size
+      const auto index = (h * newSize + w) * 4;
+      const auto target = lineSize * (heightOffset + index / rowLength) +
+                          widthOffset + index % columnLength;
+      placement.targets.push_back(
+          target >= 0 && target + 4 <= imageSize ? target : -1);
+    }
+  }
+  return placement;
+}
+
+void Flag::readResources() {
+  // the templates are shared by every generator, don't read them again when
+  // generating multiple scenarios
+  if (resourcesLoaded)
+    return;
+  readColourGroups();
+  readFlagTypes();
+  readFlagTemplates();
+  readSymbolTemplates();
+  resourcesLoaded = true;
+}
+
 void Flag::readColourGroups() {
   auto lines = PU::getLines("resources\\flags\\colour_groups.txt");
   for (const auto &line : lines) {
@@ -179,6 +244,7 @@ void Flag::readFlagTemplates() {
                                 std::to_string(i) + ".tga")) {
       flagTemplates.push_back(Gfx::Textures::readTGA(
           "resources\\flags\\flag_presets\\" + std::to_string(i) + ".tga"));
+      flagPalettes.push_back(compileTemplate(flagTemplates.back(), false));
       // get line and immediately tokenize it
       auto tokens =
           PU::getTokens(PU::getLines("resources\\flags\\flag_presets\\" +
@@ -187,6 +253,8 @@ void Flag::readFlagTemplates() {
       flagMetadata.push_back({PU::getTokens(tokens[0], ','),
                               PU::getTokens(tokens[1], ','), stod(tokens[3]),
                               stod(tokens[4]), stod(tokens[5])});
+      symbolPlacements.push_back(placeSymbol(
+          flagMetadata.back(), (int)flagTemplates.back().size()));
     }
   }
 }
@@ -196,6 +264,7 @@ void Flag::readSymbolTemplates() {
                                 std::to_string(i) + ".tga")) {
       symbolTemplates.push_back(Gfx::Textures::readTGA(
           "resources\\flags\\symbol_presets\\" + std::to_string(i) + ".tga"));
+      symbolPalettes.push_back(compileTemplate(symbolTemplates.back(), true));
       // get line and immediately tokenize it
       auto tokens =
           PU::getTokens(PU::getLines("resources\\flags\\symbol_presets\\" +
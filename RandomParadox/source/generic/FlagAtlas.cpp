@@ -0,0 +1,52 @@
+#include "generic/FlagAtlas.h"
+#include "generic/RandomStream.h"
+#include "generic/TaskGraph.h"
+#include <algorithm>
+
+namespace Scenario::Gfx {
+FlagAtlas::FlagAtlas() : width{0}, height{0} {}
+
+FlagAtlas::FlagAtlas(const int width, const int height)
+    : width{width}, height{height} {}
+
+FlagAtlas::~FlagAtlas() {}
+
+int FlagAtlas::size() const {
+  return width > 0 && height > 0
+             ? (int)(pixels.size() / (width * height * 4))
+             : 0;
+}
+
+void FlagAtlas::generate(const int count, const std::uint32_t seed,
+                         const unsigned int numThreads) {
+  pixels.assign((size_t)count * width * height * 4, 0);
+  TaskGraph::parallelFor(
+      "flags", count, numThreads, [&](int, int first, int end) {
+        for (auto index = first; index < end; index++) {
+          RandomStream random(seed, "flags", (std::uint32_t)index);
+          const auto image = Flag(width, height, random).getFlag();
+          std::copy_n(image.begin(),
+                      std::min(image.size(), flag(index).size()),
+                      pixels.begin() + (size_t)index * width * height * 4);
+        }
+      });
+}
+
+std::span<const uint8_t> FlagAtlas::flag(const int index) const {
+  return std::span<const uint8_t>(pixels).subspan(
+      (size_t)index * width * height * 4, (size_t)width * height * 4);
+}
+
+std::vector<uint8_t> FlagAtlas::resize(const int index, const int width,
+                                       const int height) const {
+  const auto image = flag(index);
+  std::vector<uint8_t> resized(width * height * 4, 0);
+  // sample every factor-th pixel, like Flag::resize
+  const auto factor = this->width / width;
+  for (auto h = 0; h < height; h++)
+    for (auto w = 0; w < width; w++)
+      std::copy_n(&image[(factor * h * this->width + factor * w) * 4], 4,
+                  &resized[(h * width + w) * 4]);
+  return resized;
+}
+} // namespace Scenario::Gfx
@@ -1,4 +1,5 @@
 #include "generic/FormatConverter.h"
+#include "generic/Tracing.h"
 namespace Scenario::Gfx {
 using namespace Textures;
 using namespace Fwg;
@@ -86,7 +87,7 @@ Bitmap FormatConverter::cutBaseMap(const std::string &path, const double factor,
                                    const int bit) const {
   auto &conf = Cfg::Values();
   std::string sourceMap{conf.loadMapsPath + path};
-  Fwg::Utils::Logging::logLine("CUTTING mode: Cutting Map from ", sourceMap);
+  Tracing::logLine("CUTTING mode: Cutting Map from ", sourceMap);
   Bitmap baseMap =
       bit == 24 ? Bmp::load24Bit(sourceMap, "") : Bmp::load8Bit(sourceMap, "");
   auto cutBase = Bmp::cut(baseMap, conf.minX * factor, conf.maxX * factor,
@@ -101,20 +102,21 @@ Bitmap FormatConverter::cutBaseMap(const std::string &path, const double factor,
 void FormatConverter::dump8BitHeightmap(const Bitmap &heightMap,
                                         const std::string &path,
                                         const std::string &colourMapKey) const {
-  Utils::Logging::logLine("FormatConverter::Copying heightmap to ", path);
+  Tracing::logLine("FormatConverter::Copying heightmap to ", path);
   Bitmap hoi4Heightmap(Cfg::Values().width, Cfg::Values().height, 8);
   hoi4Heightmap.colourtable = colourTables.at(colourMapKey + gameTag);
   // now map from 24 bit climate map
   for (int i = 0; i < Cfg::Values().bitmapSize; i++)
     hoi4Heightmap.bit8Buffer[i] = heightMap[i].getRed();
   Bmp::save(hoi4Heightmap, path);
+  Tracing::addFileBytes(path);
 }
 
 void FormatConverter::dump8BitTerrain(const Bitmap &climateIn,
                                       const std::string &path,
                                       const std::string &colourMapKey,
                                       const bool cut) const {
-  Utils::Logging::logLine("FormatConverter::Writing terrain to ", path);
+  Tracing::logLine("FormatConverter::Writing terrain to ", path);
   auto &conf = Cfg::Values();
   Bitmap hoi4terrain(conf.width, conf.height, 8);
   hoi4terrain.colourtable = colourTables.at(colourMapKey + gameTag);
@@ -130,13 +132,14 @@ void FormatConverter::dump8BitTerrain(const Bitmap &climateIn,
     hoi4terrain = cutBaseMap("\\terrain.bmp");
   }
   Bmp::save(hoi4terrain, path);
+  Tracing::addFileBytes(path);
 }
 
 void FormatConverter::dump8BitCities(const Bitmap &climateIn,
                                      const std::string &path,
                                      const std::string &colourMapKey,
                                      const bool cut) const {
-  Utils::Logging::logLine("FormatConverter::Writing cities to ", path);
+  Tracing::logLine("FormatConverter::Writing cities to ", path);
   Bitmap cities(Cfg::Values().width, Cfg::Values().height, 8);
   cities.colourtable = colourTables.at(colourMapKey + gameTag);
   if (!cut) {
@@ -147,13 +150,14 @@ void FormatConverter::dump8BitCities(const Bitmap &climateIn,
     cities = cutBaseMap("\\cities.bmp");
   }
   Bmp::save(cities, path);
+  Tracing::addFileBytes(path);
 }
 
 void FormatConverter::dump8BitRivers(const Bitmap &riversIn,
                                      const std::string &path,
                                      const std::string &colourMapKey,
                                      const bool cut) const {
-  Utils::Logging::logLine("FormatConverter::Writing rivers to ", path);
+  Tracing::logLine("FormatConverter::Writing rivers to ", path);
   Bitmap rivers(Cfg::Values().width, Cfg::Values().height, 8);
   rivers.colourtable = colourTables.at(colourMapKey + gameTag);
 
@@ -165,6 +169,7 @@ void FormatConverter::dump8BitRivers(const Bitmap &riversIn,
     rivers = cutBaseMap("\\rivers.bmp");
   }
   Bmp::save(rivers, path);
+  Tracing::addFileBytes(path);
 }
 
 void FormatConverter::dump8BitTrees(const Bitmap &climate,
@@ -172,7 +177,7 @@ void FormatConverter::dump8BitTrees(const Bitmap &climate,
                                     const std::string &path,
                                     const std::string &colourMapKey,
                                     const bool cut) const {
-  Utils::Logging::logLine("FormatConverter::Writing trees to ", path);
+  Tracing::logLine("FormatConverter::Writing trees to ", path);
   const double width = Cfg::Values().width;
   constexpr auto factor = 3.4133333333333333333333333333333;
   Bitmap trees(((double)Cfg::Values().width / factor),
@@ -195,13 +200,14 @@ void FormatConverter::dump8BitTrees(const Bitmap &climate,
     trees = cutBaseMap("\\trees.bmp", (1.0 / factor));
   }
   Bmp::save(trees, path);
+  Tracing::addFileBytes(path);
 }
 
 void FormatConverter::dumpDDSFiles(const Bitmap &riverMap,
                                    const Bitmap &heightMap,
                                    const std::string &path, const bool cut,
                                    const int maxFactor) const {
-  Utils::Logging::logLine("FormatConverter::Writing DDS files to ", path);
+  Tracing::logLine("FormatConverter::Writing DDS files to ", path);
   using namespace DirectX;
   const auto &width = Cfg::Values().width;
 
@@ -247,8 +253,8 @@ void FormatConverter::dumpTerrainColourmap(const Bitmap &climateMap,
                                            const std::string &mapName,
                                            const DXGI_FORMAT format,
                                            const bool cut) const {
-  Utils::Logging::logLine("FormatConverter::Writing terrain colourmap to ",
-                          modPath + mapName);
+  Tracing::logLine("FormatConverter::Writing terrain colourmap to ",
+                   modPath + mapName);
   auto &config = Cfg::Values();
   const auto &height = config.height;
   const auto &width = config.width;
@@ -303,7 +309,7 @@ void FormatConverter::dumpTerrainColourmap(const Bitmap &climateMap,
 void FormatConverter::dumpWorldNormal(const Bitmap &sobelMap,
                                       const std::string &path,
                                       const bool cut) const {
-  Utils::Logging::logLine("FormatConverter::Writing normalMap to ", path);
+  Tracing::logLine("FormatConverter::Writing normalMap to ", path);
   auto height = Cfg::Values().height;
   auto width = Cfg::Values().width;
 
@@ -320,8 +326,11 @@ void FormatConverter::dumpWorldNormal(const Bitmap &sobelMap,
       normalMap.imageData = Bmp::filter(normalMap);
   }
   Bmp::save(normalMap, (path).c_str());
+  Tracing::addFileBytes(path);
 }
 
+FormatConverter::FormatConverter() {}
+
 FormatConverter::FormatConverter(const std::string &gamePath,
                                  const std::string &gameTag)
     : gamePath{gamePath}, gameTag{gameTag} {
@@ -1,12 +1,10 @@
 #include "generic/GameProvince.h"
 namespace Scenario {
 GameProvince::GameProvince(Fwg::Province *province)
-    : ID(province->ID), baseProvince(province), popFactor(0.0), devFactor(0.0),
-      cityShare(0.0) {}
+    : ID(province->ID), baseProvince(province) {}
 
 GameProvince::GameProvince()
-    : ID(-1), baseProvince(nullptr), popFactor(0.0), devFactor(0.0),
-      cityShare(0.0) {}
+    : ID(-1), baseProvince(nullptr) {}
 
 GameProvince::~GameProvince() {}
 } // namespace Scenario
\ No newline at end of file
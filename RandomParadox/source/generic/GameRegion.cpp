@@ -1,9 +1,9 @@
 #include "generic/GameRegion.h"
 namespace Scenario {
-Region::Region() {}
+Region::Region() : owner(-1), assigned(false) {}
 
 Region::Region(const Fwg::Region &baseRegion)
-    : Fwg::Region(baseRegion), assigned(false) {}
+    : Fwg::Region(baseRegion), owner(-1), assigned(false) {}
 
 Region::~Region() {}
 } // namespace Scenario
\ No newline at end of file
@@ -1,5 +1,17 @@
 #include "generic/GenericModule.h"
+#include "generic/DebugMaps.h"
+#include "RandNum/RandNum.h"
+#include <random>
 namespace Scenario {
+static bool interactiveRun = true;
+
+void setInteractive(const bool interactive) { interactiveRun = interactive; }
+
+void pause() {
+  if (interactiveRun)
+    system("pause");
+}
+
 void GenericModule::createPaths(const std::string &basePath) { // mod directory
   using namespace std::filesystem;
   create_directory(basePath);
@@ -37,7 +49,7 @@ bool GenericModule::findGame(std::string &path, const std::string &game) {
         " it doesn't exist or is malformed. Auto search will now "
         "try to locate the game, but may not succeed. It is "
         "recommended to correctly configure the path");
-    system("pause");
+    pause();
   }
   for (const auto &drive : drives) {
     if (exists(drive + "Program Files (x86)\\Steam\\steamapps\\common\\" +
@@ -73,7 +85,7 @@ bool GenericModule::findModFolders() {
         "path ",
         modsDir.parent_path(),
         " it doesn't exist or is malformed. Please correct the path");
-    system("pause");
+    pause();
     return false;
   }
   if (exists(gameModsDirectory)) {
@@ -83,7 +95,7 @@ bool GenericModule::findModFolders() {
         "Could not find game mods directory folder under configured path ",
         gameModsDirectory,
         " it doesn't exist or is malformed. Please correct the path");
-    system("pause");
+    pause();
     return false;
   }
   return true;
@@ -103,4 +115,62 @@ void GenericModule::configurePaths(
   gameModsDirectory = gamesConf.get<std::string>(gameName + ".modsDirectory");
   ParserUtils::replaceOccurences(gameModsDirectory, "<username>", username);
 }
+
+void GenericModule::applyRunSettings(const int seed, const bool writeMaps) {
+  auto &config = Fwg::Cfg::Values();
+  config.seed = seed;
+  config.writeMaps = writeMaps;
+  std::mt19937 layerSeeds(seed);
+  for (auto &layerSeed : config.seeds)
+    layerSeed = (int)(layerSeeds() >> 1);
+  RandNum::gen.seed(seed);
+}
+
+void GenericModule::runJob(const boost::property_tree::ptree &job,
+                           const std::function<void()> &generate) {
+  auto &config = Fwg::Cfg::Values();
+  const auto baseModName = modName;
+  const auto baseModPath = gameModPath;
+  const auto baseNumCountries = numCountries;
+  const auto baseSeed = config.seed;
+  const auto baseSeeds = config.seeds;
+  const auto baseWriteMaps = config.writeMaps;
+  auto restore = [&] {
+    modName = baseModName;
+    gameModPath = baseModPath;
+    numCountries = baseNumCountries;
+    applyRunSettings(baseSeed, baseWriteMaps);
+    config.seeds = baseSeeds;
+  };
+  std::string suffix = "";
+  if (const auto seed = job.get_optional<int>("seed")) {
+    config.seed = *seed;
+    suffix = std::to_string(*seed);
+  }
+  if (const auto name = job.get_optional<std::string>("name"))
+    suffix = *name;
+  if (suffix.size()) {
+    modName = baseModName + "_" + suffix;
+    gameModPath = baseModPath + "_" + suffix;
+  }
+  numCountries = job.get<int>("numCountries", numCountries);
+  config.writeMaps = job.get<bool>("writeMaps", config.writeMaps);
+  try {
+    generate();
+    // every job starts with an empty queue of debug maps
+    DebugMaps::flush();
+  } catch (std::exception e) {
+    // the job failed already, a failing map is only reported, so it can't
+    // fail the next job either
+    try {
+      DebugMaps::flush();
+    } catch (std::exception mapError) {
+      Fwg::Utils::Logging::logLine("Error while writing debug maps: ",
+                                   mapError.what());
+    }
+    restore();
+    throw;
+  }
+  restore();
+}
 } // namespace Scenario
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "generic/LabelRasters.h"
+#include "generic/TaskGraph.h"
+#include <algorithm>
+namespace Scenario {
+LabelRasters::LabelRasters() {}
+
+LabelRasters::~LabelRasters() {}
+
+void LabelRasters::build(
+    const std::vector<std::span<const PixelSpan>> &provinceSpans,
+    const int width, const int height) {
+  this->width = width;
+  this->height = height;
+  provinces.assign((size_t)width * height, none);
+  for (std::uint32_t ID = 0; ID < provinceSpans.size(); ID++)
+    for (const auto &span : provinceSpans[ID])
+      std::fill_n(provinces.begin() + span.row * width + span.start,
+                  span.length, ID);
+  regions.clear();
+  countries.clear();
+}
+
+std::vector<std::uint32_t>
+LabelRasters::derive(const std::vector<std::uint32_t> &source,
+                     const std::vector<std::uint32_t> &lookup) const {
+  std::vector<std::uint32_t> target(source.size());
+  forEachBand([&](int, int firstRow, int endRow) {
+    for (auto pix = firstRow * width; pix < endRow * width; pix++)
+      target[pix] = source[pix] == none ? none : lookup[source[pix]];
+  });
+  return target;
+}
+
+int LabelRasters::bandCount() const {
+  return TaskGraph::chunkCount(height, numThreads);
+}
+
+void LabelRasters::forEachBand(
+    const std::function<void(int band, int firstRow, int endRow)> &sweep)
+    const {
+  TaskGraph::parallelFor("rows", height, numThreads, sweep);
+}
+} // namespace Scenario
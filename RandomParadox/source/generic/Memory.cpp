@@ -0,0 +1,67 @@
+#include "generic/Memory.h"
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#ifdef RPD_COUNT_ALLOCATIONS
+// per thread, so concurrent scopes don't count each other's allocations
+static thread_local unsigned long long allocationCount = 0;
+static thread_local unsigned long long allocationBytes = 0;
+
+void *operator new(std::size_t size) {
+  allocationCount++;
+  allocationBytes += size;
+  if (auto pointer = std::malloc(size ? size : 1))
+    return pointer;
+  throw std::bad_alloc();
+}
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+#endif
+
+namespace Scenario::Memory {
+Usage getUsage() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return {0, 0};
+  return {counters.WorkingSetSize, counters.PeakWorkingSetSize};
+#else
+  // second field of statm is the number of resident pages
+  std::size_t pages = 0, residentPages = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> pages >> residentPages;
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  // ru_maxrss is given in kilobytes
+  return {residentPages * sysconf(_SC_PAGESIZE),
+          static_cast<std::size_t>(usage.ru_maxrss) * 1024};
+#endif
+}
+
+Allocations getAllocations() {
+#ifdef RPD_COUNT_ALLOCATIONS
+  return {allocationCount, allocationBytes};
+#else
+  return {0, 0};
+#endif
+}
+
+void addAllocations(const Allocations &allocations) {
+#ifdef RPD_COUNT_ALLOCATIONS
+  allocationCount += allocations.count;
+  allocationBytes += allocations.bytes;
+#endif
+}
+} // namespace Scenario::Memory
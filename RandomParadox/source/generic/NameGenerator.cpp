@@ -1,4 +1,6 @@
 #include "generic/NameGenerator.h"
+#include "generic/RandomStream.h"
+#include "generic/TaskGraph.h"
 
 namespace Scenario {
 namespace NameGeneration {
@@ -11,6 +13,58 @@ std::string generateName(const NameData &nameData) {
   return name;
 }
 
+size_t NameList::size() const { return offsets.size() - 1; }
+
+std::string_view NameList::operator[](const size_t i) const {
+  return std::string_view(characters).substr(offsets[i],
+                                             offsets[i + 1] - offsets[i]);
+}
+
+NameList generateNames(const NameData &nameData, const size_t count,
+                       const std::string &stage, const std::uint32_t seed,
+                       const unsigned int numThreads) {
+  if (nameData.nameRules.empty())
+    throw(std::exception("Error in Name Generation. No name rules loaded"));
+  // resolve the token groups of every rule once
+  std::vector<std::vector<const std::vector<std::string> *>> rules;
+  for (const auto &rule : nameData.nameRules) {
+    rules.push_back({});
+    for (const auto &key : ParserUtils::getTokens(rule, ';')) {
+      const auto group = nameData.groups.find(key);
+      if (group == nameData.groups.end() || group->second.empty()) {
+        auto str = "Error in Name Generation. Make sure the key: \"" + key +
+                   "\" of the namegroup or token group is present";
+        throw(std::exception(str.c_str()));
+      }
+      rules.back().push_back(&group->second);
+    }
+  }
+  // every chunk of names is written to its own list, which are joined after
+  std::vector<NameList> chunks(TaskGraph::chunkCount((int)count, numThreads));
+  TaskGraph::parallelFor(
+      "generateNames", (int)count, numThreads,
+      [&](int chunk, int first, int end) {
+        auto &names = chunks[chunk];
+        for (auto i = first; i < end; i++) {
+          RandomStream random(seed, stage, (std::uint32_t)i);
+          const auto start = names.characters.size();
+          for (const auto group : random.selectRandom(rules))
+            names.characters += random.selectRandom(*group);
+          if (names.characters.size() > start)
+            names.characters[start] = ::toupper(names.characters[start]);
+          names.offsets.push_back(names.characters.size());
+        }
+      });
+  NameList names;
+  for (const auto &chunk : chunks) {
+    const auto base = names.characters.size();
+    names.characters += chunk.characters;
+    for (auto i = 1; i < chunk.offsets.size(); i++)
+      names.offsets.push_back(base + chunk.offsets[i]);
+  }
+  return names;
+}
+
 std::string generateAdjective(const std::string &name,
                               const NameData &nameData) {
   for (const auto &vowel : nameData.groups.at("vowels"))
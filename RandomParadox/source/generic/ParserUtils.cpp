@@ -1,4 +1,5 @@
 #include "generic/ParserUtils.h"
+#include "generic/Tracing.h"
 
 namespace Scenario::ParserUtils {
 
@@ -15,6 +16,7 @@ void writeFile(const std::string &path, std::string content, bool utf8) {
   }
   file << content;
   file.close();
+  Tracing::addBytes(content.size() + (utf8 ? 3 : 0));
 };
 std::string readFile(std::string path) {
   std::string content{""};
@@ -1,10 +1,18 @@
 #include "generic/PdoxCountry.h"
 namespace Scenario {
-PdoxCountry::PdoxCountry() : ID{-1} {}
+std::uint32_t packTag(const std::string &tag) {
+  std::uint32_t packed = 0;
+  for (const auto letter : tag.substr(0, 4))
+    packed = packed << 8 | (unsigned char)letter;
+  return packed;
+}
+
+PdoxCountry::PdoxCountry() : ID{-1}, flagIndex{-1} {}
 
 PdoxCountry::PdoxCountry(std::string tag, int ID, std::string name,
-                         std::string adjective, Gfx::Flag flag)
-    : ID{ID}, tag{tag}, name{name}, adjective{adjective}, flag{flag} {
+                         std::string adjective, int flagIndex)
+    : ID{ID}, tag{tag}, name{name}, adjective{adjective},
+      flagIndex{flagIndex} {
   colour = {static_cast<unsigned char>(RandNum::getRandom(0, 255) ),
             static_cast<unsigned char>(RandNum::getRandom(0, 255)),
             static_cast<unsigned char>(RandNum::getRandom(0, 255))};
@@ -12,39 +20,17 @@ PdoxCountry::PdoxCountry(std::string tag, int ID, std::string name,
 
 PdoxCountry::~PdoxCountry() {}
 
-void PdoxCountry::assignRegions(int maxRegions,
-                                std::vector<Region> &gameRegions,
-                                Region &startRegion,
-                                std::vector<GameProvince> &gameProvinces) {
-  addRegion(startRegion, gameRegions, gameProvinces);
-  auto breakCounter = 0;
-  while (ownedRegions.size() < maxRegions && breakCounter++ < 100) {
-    for (const auto &gameRegion : ownedRegions) {
-      if (ownedRegions.size() >= maxRegions)
-        break;
-      if (gameRegions[gameRegion].neighbours.size() == 0)
-        continue;
-      auto &nextRegion =
-          Fwg::Utils::selectRandom(gameRegions[gameRegion].neighbours);
-      if (!gameRegions[nextRegion].assigned && !gameRegions[nextRegion].sea) {
-        gameRegions[nextRegion].assigned = true;
-        addRegion(gameRegions[nextRegion], gameRegions, gameProvinces);
-      }
-    }
-  }
-}
-
 void PdoxCountry::addRegion(Region &region,
                             std::vector<Region> &gameRegions,
-                            std::vector<GameProvince> &gameProvinces) {
+                            ProvinceTable &provinceTable,
+                            RegionPool &freeRegions) {
   gameRegions[region.ID].assigned = true;
-  gameRegions[region.ID].owner = tag;
-  for (auto &gameProvince : gameRegions[region.ID].gameProvinces)
-    gameProvince.owner = tag;
+  gameRegions[region.ID].owner = ID;
+  for (const auto &province : region.provinces)
+    provinceTable.owners[province->ID] = ID;
   region.assigned = true;
-  region.owner = tag;
-  for (auto &gameProvince : region.gameProvinces)
-    gameProvince.owner = tag;
+  region.owner = ID;
   ownedRegions.push_back(region.ID);
+  freeRegions.remove(region.ID);
 }
 } // namespace Scenario
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "generic/PixelSpans.h"
+#include <algorithm>
+namespace Scenario {
+std::vector<PixelSpan> toSpans(std::vector<int> pixels, const int width) {
+  std::vector<PixelSpan> spans;
+  std::sort(pixels.begin(), pixels.end());
+  for (const auto pix : pixels) {
+    const auto row = pix / width;
+    const auto x = pix % width;
+    // extend the current run if this pixel directly follows it, duplicates
+    // are already covered
+    if (spans.size() && spans.back().row == row &&
+        x <= spans.back().start + spans.back().length) {
+      spans.back().length = x - spans.back().start + 1;
+      continue;
+    }
+    spans.push_back({row, x, 1});
+  }
+  return spans;
+}
+
+int pixelCount(std::span<const PixelSpan> spans) {
+  auto count = 0;
+  for (const auto &span : spans)
+    count += span.length;
+  return count;
+}
+
+void fill(Fwg::Gfx::Bitmap &bitmap, std::span<const PixelSpan> spans,
+          const Fwg::Gfx::Colour &colour) {
+  const auto width = bitmap.bInfoHeader.biWidth;
+  for (const auto &span : spans)
+    std::fill_n(bitmap.imageData.begin() + span.row * width + span.start,
+                span.length, colour);
+}
+} // namespace Scenario
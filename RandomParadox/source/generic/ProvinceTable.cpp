@@ -0,0 +1,97 @@
+#include "generic/ProvinceTable.h"
+namespace Scenario {
+const std::vector<std::string> ProvinceTable::terrainTypes{
+    "",       "plains", "forest", "marsh", "hills",
+    "mountain", "desert", "urban",  "jungle"};
+
+ProvinceTable::ProvinceTable() {}
+
+ProvinceTable::~ProvinceTable() {}
+
+void ProvinceTable::build(const std::vector<Fwg::Province *> &provinces,
+                          const int width) {
+  this->width = width;
+  const auto count = provinces.size();
+  baseProvinces.assign(count, nullptr);
+  owners.assign(count, -1);
+  terrainIDs.assign(count, 0);
+  popFactors.assign(count, 0.0);
+  devFactors.assign(count, 0.0);
+  cityShares.assign(count, 0.0);
+  areas.assign(count, 0);
+  cityPixels.assign(count, 0);
+  populationSamples.assign(count, 0.0);
+  cityDensities.assign(count, 0.0);
+  climatePalette.clear();
+  climateHistograms.clear();
+  doubleAttributes.assign(knownDoubleAttributes, std::vector<double>(count));
+  doubleAttributeIDs = {{"naval_bases", navalBases}};
+  stringAttributes.clear();
+  stringAttributeIDs.clear();
+  for (const auto province : provinces) {
+    if (province->ID < 0 || province->ID >= count)
+      throw(std::exception("Fatal: Invalid province IDs, terminating"));
+    baseProvinces[province->ID] = province;
+  }
+  // count first, so the neighbours can be written in place
+  neighbourOffsets.assign(count + 1, 0);
+  for (auto ID = 0; ID < count; ID++)
+    neighbourOffsets[ID + 1] =
+        neighbourOffsets[ID] + baseProvinces[ID]->neighbours.size();
+  neighbourIDs.resize(neighbourOffsets[count]);
+  for (auto ID = 0; ID < count; ID++) {
+    auto offset = neighbourOffsets[ID];
+    for (const auto neighbour : baseProvinces[ID]->neighbours)
+      neighbourIDs[offset++] = neighbour->ID;
+  }
+  spanOffsets.assign(count + 1, 0);
+  pixelSpans.clear();
+  for (auto ID = 0; ID < count; ID++) {
+    const auto provinceSpans = toSpans(baseProvinces[ID]->pixels, width);
+    pixelSpans.insert(pixelSpans.end(), provinceSpans.begin(),
+                      provinceSpans.end());
+    spanOffsets[ID + 1] = (int)pixelSpans.size();
+  }
+}
+
+int ProvinceTable::size() const { return (int)baseProvinces.size(); }
+
+std::span<const int> ProvinceTable::neighbours(const int ID) const {
+  return {neighbourIDs.data() + neighbourOffsets[ID],
+          neighbourIDs.data() + neighbourOffsets[ID + 1]};
+}
+
+std::span<const PixelSpan> ProvinceTable::spans(const int ID) const {
+  return {pixelSpans.data() + spanOffsets[ID],
+          pixelSpans.data() + spanOffsets[ID + 1]};
+}
+
+const std::string &ProvinceTable::terrainType(const int ID) const {
+  return terrainTypes[terrainIDs[ID]];
+}
+
+void ProvinceTable::setTerrainType(const int ID,
+                                   const std::string &terrainType) {
+  const auto terrain =
+      std::find(terrainTypes.begin(), terrainTypes.end(), terrainType);
+  if (terrain == terrainTypes.end())
+    throw(std::exception(("Unknown terrain type " + terrainType).c_str()));
+  terrainIDs[ID] = (unsigned char)(terrain - terrainTypes.begin());
+}
+
+int ProvinceTable::doubleAttributeID(const std::string &key) {
+  const auto known = doubleAttributeIDs.find(key);
+  if (known != doubleAttributeIDs.end())
+    return known->second;
+  doubleAttributes.push_back(std::vector<double>(size()));
+  return doubleAttributeIDs[key] = (int)doubleAttributes.size() - 1;
+}
+
+int ProvinceTable::stringAttributeID(const std::string &key) {
+  const auto known = stringAttributeIDs.find(key);
+  if (known != stringAttributeIDs.end())
+    return known->second;
+  stringAttributes.push_back(std::vector<std::string>(size()));
+  return stringAttributeIDs[key] = (int)stringAttributes.size() - 1;
+}
+} // namespace Scenario
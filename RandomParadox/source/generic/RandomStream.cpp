@@ -0,0 +1,57 @@
+#include "generic/RandomStream.h"
+namespace Scenario {
+RandomStream::Block RandomStream::philox(Block counter, Key key) {
+  for (auto round = 0; round < 10; round++) {
+    if (round) {
+      key[0] += 0x9E3779B9;
+      key[1] += 0xBB67AE85;
+    }
+    const auto product0 = (std::uint64_t)0xD2511F53 * counter[0];
+    const auto product1 = (std::uint64_t)0xCD9E8D57 * counter[2];
+    counter = {(std::uint32_t)(product1 >> 32) ^ counter[1] ^ key[0],
+               (std::uint32_t)product1,
+               (std::uint32_t)(product0 >> 32) ^ counter[3] ^ key[1],
+               (std::uint32_t)product0};
+  }
+  return counter;
+}
+
+std::uint32_t RandomStream::stageKey(const std::string &stage) {
+  // FNV-1a
+  std::uint32_t hash = 2166136261u;
+  for (const auto letter : stage)
+    hash = (hash ^ (unsigned char)letter) * 16777619u;
+  return hash;
+}
+
+RandomStream::RandomStream(const std::uint32_t seed, const std::string &stage,
+                           const std::uint32_t entity)
+    : key{seed, stageKey(stage)}, counter{0, 0, entity, 0} {}
+
+RandomStream::~RandomStream() {}
+
+std::uint32_t RandomStream::next() {
+  if (used == 4) {
+    block = philox(counter, key);
+    used = 0;
+    // the lower two words count the blocks of this stream
+    if (!++counter[0])
+      counter[1]++;
+  }
+  return block[used++];
+}
+
+int RandomStream::getRandom(const int min, const int max) {
+  const auto range = (std::uint64_t)((std::int64_t)max - min + 1);
+  return (int)(min + (std::int64_t)((next() * range) >> 32));
+}
+
+double RandomStream::getRandom(const double min, const double max) {
+  // 53 random bits, exactly representable. The words are read in sequence,
+  // so the result doesn't depend on the evaluation order of the compiler
+  const std::uint64_t high = next();
+  const std::uint64_t low = next();
+  const auto bits = (high << 21) ^ (low >> 11);
+  return min + (max - min) * (bits * 0x1.0p-53);
+}
+} // namespace Scenario
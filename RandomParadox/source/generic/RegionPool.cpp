@@ -0,0 +1,37 @@
+#include "generic/RegionPool.h"
+namespace Scenario {
+RegionPool::RegionPool() {}
+
+RegionPool::~RegionPool() {}
+
+void RegionPool::build(const std::vector<Region> &gameRegions) {
+  regionIDs.clear();
+  slots.assign(gameRegions.size(), -1);
+  for (const auto &gameRegion : gameRegions) {
+    if (gameRegion.assigned || gameRegion.sea)
+      continue;
+    slots[gameRegion.ID] = (int)regionIDs.size();
+    regionIDs.push_back(gameRegion.ID);
+  }
+}
+
+bool RegionPool::empty() const { return regionIDs.empty(); }
+
+int RegionPool::size() const { return (int)regionIDs.size(); }
+
+bool RegionPool::contains(const int regionID) const {
+  return regionID < slots.size() && slots[regionID] != -1;
+}
+
+void RegionPool::remove(const int regionID) {
+  if (!contains(regionID))
+    return;
+  const auto slot = slots[regionID];
+  regionIDs[slot] = regionIDs.back();
+  slots[regionIDs[slot]] = slot;
+  regionIDs.pop_back();
+  slots[regionID] = -1;
+}
+
+int RegionPool::random() { return Fwg::Utils::selectRandom(regionIDs); }
+} // namespace Scenario
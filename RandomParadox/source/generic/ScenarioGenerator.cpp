@@ -3,11 +3,9 @@ namespace Logging = Fwg::Utils::Logging;
 namespace Scenario {
 using namespace Fwg::Gfx;
 Generator::Generator() {}
-Generator::Generator(Fwg::FastWorldGenerator &fwg) : fwg(fwg) {
-  Gfx::Flag::readColourGroups();
-  Gfx::Flag::readFlagTypes();
-  Gfx::Flag::readFlagTemplates();
-  Gfx::Flag::readSymbolTemplates();
+Generator::Generator(std::shared_ptr<Fwg::FastWorldGenerator> fwg)
+    : fwg(fwg) {
+  Gfx::Flag::readResources();
 }
 
 Generator::~Generator() {}
@@ -18,22 +16,32 @@ void Generator::loadRequiredResources(const std::string &gamePath) {
 }
 
 void Generator::generateWorld() {
+  Tracing::ScopedTimer timer("generateWorld");
+  gatherProvinceStatistics();
   mapTerrain();
   generatePopulations();
   generateDevelopment();
 }
 
 void Generator::mapContinents() {
+  Tracing::ScopedTimer timer("mapContinents");
   Logging::logLine("Mapping Continents");
-  for (const auto &continent : fwg.areas.continents) {
+  for (const auto &continent : fwg->areas.continents) {
     // we copy the fwg continents by choice, to leave them untouched
     pdoxContinents.push_back(PdoxContinent(continent));
   }
 }
 
 void Generator::mapRegions() {
+  Tracing::ScopedTimer timer("mapRegions");
   Logging::logLine("Mapping Regions");
-  for (auto &region : fwg.areas.regions) {
+  // all names up front, drawn in parallel
+  const auto seed = (std::uint32_t)Fwg::Cfg::Values().seed;
+  const auto regionNames = NameGeneration::generateNames(
+      nData, fwg->areas.regions.size(), "regionNames", seed, numThreads);
+  const auto provinceNames = NameGeneration::generateNames(
+      nData, fwg->areas.provinces.size(), "provinceNames", seed, numThreads);
+  for (auto &region : fwg->areas.regions) {
     std::sort(region.provinces.begin(), region.provinces.end(),
               [](const Fwg::Province *a, const Fwg::Province *b) {
                 return (*a < *b);
@@ -41,26 +49,22 @@ void Generator::mapRegions() {
     Region gR(region);
     for (auto &baseRegion : gR.neighbours)
       gR.neighbours.push_back(baseRegion);
-    // generate random name for region
-    gR.name = NameGeneration::generateName(nData);
+    // give the region its name
+    gR.name = regionNames[gameRegions.size()];
     // now create gameprovinces from FastWorldGen provinces
     for (auto &province : gR.provinces) {
       GameProvince gP(province);
-      // also copy neighbours
-      for (auto &baseProvinceNeighbour : gP.baseProvince->neighbours)
-        gP.neighbours.push_back(baseProvinceNeighbour);
       // give name to province
-      gP.name = NameGeneration::generateName(nData);
-      gR.gameProvinces.push_back(gP);
+      gP.name = provinceNames[gameProvinces.size()];
       gameProvinces.push_back(gP);
     }
     // save game region
     gameRegions.push_back(gR);
   }
   // check if we have the same amount of gameProvinces as FastWorldGen provinces
-  if (gameProvinces.size() != fwg.areas.provinces.size())
+  if (gameProvinces.size() != fwg->areas.provinces.size())
     throw(std::exception("Fatal: Lost provinces, terminating"));
-  if (gameRegions.size() != fwg.areas.regions.size())
+  if (gameRegions.size() != fwg->areas.regions.size())
     throw(std::exception("Fatal: Lost regions, terminating"));
   for (const auto &gameRegion : gameRegions) {
     if (gameRegion.ID > gameRegions.size()) {
@@ -69,140 +73,236 @@ void Generator::mapRegions() {
   }
   // sort by gameprovince ID
   std::sort(gameProvinces.begin(), gameProvinces.end());
+  // flat per province data, adjacency and pixel runs, filled by the later
+  // stages
+  provinceTable.build(fwg->areas.provinces,
+                      fwg->provinceMap.bInfoHeader.biWidth);
+  buildLabelRasters();
 }
 
-void Generator::generatePopulations() {
-  Logging::logLine("Generating Population");
+void Generator::buildLabelRasters() {
+  Tracing::ScopedTimer timer("buildLabelRasters");
+  labels.numThreads = numThreads;
+  std::vector<std::span<const PixelSpan>> provinceSpans;
+  for (auto ID = 0; ID < provinceTable.size(); ID++)
+    provinceSpans.push_back(provinceTable.spans(ID));
+  labels.build(provinceSpans, fwg->provinceMap.bInfoHeader.biWidth,
+               fwg->provinceMap.bInfoHeader.biHeight);
+  std::vector<std::uint32_t> provinceRegions(provinceTable.size(),
+                                             LabelRasters::none);
+  for (const auto &gameRegion : gameRegions)
+    for (const auto &province : gameRegion.provinces)
+      provinceRegions[province->ID] = gameRegion.ID;
+  labels.regions = labels.derive(labels.provinces, provinceRegions);
+}
+
+void Generator::labelCountries() {
+  Tracing::ScopedTimer timer("labelCountries");
+  std::vector<std::uint32_t> regionOwners(gameRegions.size(),
+                                          LabelRasters::none);
+  for (const auto &gameRegion : gameRegions)
+    if (gameRegion.owner != -1)
+      regionOwners[gameRegion.ID] = gameRegion.owner;
+  labels.countries = labels.derive(labels.regions, regionOwners);
+}
+
+void Generator::gatherProvinceStatistics() {
+  Tracing::ScopedTimer timer("gatherProvinceStatistics");
   auto &config = Fwg::Cfg::Values();
-  const auto &popMap = fwg.populationMap;
-  const auto &cityMap = fwg.cityMap;
-  for (auto &c : countries)
-    for (auto &gR : c.second.ownedRegions)
-      for (auto &gProv : gameRegions[gR].gameProvinces) {
-        // calculate the population factor
-        gProv.popFactor =
-            0.1 + popMap[gProv.baseProvince->position.weightedCenter] /
-                      config.colours["population"];
-        int cityPixels = 0;
-        // calculate share of province that is a city
-        for (auto pix : gProv.baseProvince->pixels)
-          if (cityMap[pix].isShadeOf(
-                  config.colours["cities"]))
-            cityPixels++;
-        gProv.cityShare =
-            (double)cityPixels / gProv.baseProvince->pixels.size();
+  const auto &popMap = fwg->populationMap;
+  const auto &cityMap = fwg->cityMap;
+  const auto &climateMap = fwg->climateMap;
+  const auto populationColour = config.colours["population"];
+  const auto cityColour = config.colours["cities"];
+  // the palette is gathered first, sorted like the keys of a colour map, so
+  // every band can count into one flat array of provinces x palette size
+  std::vector<std::set<Fwg::Gfx::Colour>> bandColours(labels.bandCount());
+  labels.forEachBand([&](int band, int firstRow, int endRow) {
+    auto &colours = bandColours[band];
+    // climate colours come in runs, so only changes are looked up
+    Fwg::Gfx::Colour lastColour;
+    for (auto pix = firstRow * labels.width; pix < endRow * labels.width;
+         pix++) {
+      if (labels.provinces[pix] == LabelRasters::none)
+        continue;
+      if (colours.empty() || climateMap[pix] != lastColour) {
+        lastColour = climateMap[pix];
+        colours.insert(lastColour);
+      }
+    }
+  });
+  std::map<Fwg::Gfx::Colour, int> paletteIDs;
+  for (const auto &colours : bandColours)
+    for (const auto &colour : colours)
+      paletteIDs.emplace(colour, 0);
+  auto &palette = provinceTable.climatePalette;
+  palette.clear();
+  for (auto &[colour, paletteID] : paletteIDs) {
+    paletteID = (int)palette.size();
+    palette.push_back(colour);
+  }
+  // every band of rows counts into its own statistics
+  struct BandStatistics {
+    std::vector<int> areas;
+    std::vector<int> cityPixels;
+    std::vector<int> climateHistograms;
+  };
+  std::vector<BandStatistics> bandStatistics(labels.bandCount());
+  labels.forEachBand([&](int band, int firstRow, int endRow) {
+    auto &statistics = bandStatistics[band];
+    statistics.areas.assign(provinceTable.size(), 0);
+    statistics.cityPixels.assign(provinceTable.size(), 0);
+    statistics.climateHistograms.assign(provinceTable.size() * palette.size(),
+                                        0);
+    auto paletteID = -1;
+    Fwg::Gfx::Colour lastColour;
+    for (auto pix = firstRow * labels.width; pix < endRow * labels.width;
+         pix++) {
+      const auto ID = labels.provinces[pix];
+      if (ID == LabelRasters::none)
+        continue;
+      statistics.areas[ID]++;
+      if (cityMap[pix].isShadeOf(cityColour))
+        statistics.cityPixels[ID]++;
+      if (paletteID == -1 || climateMap[pix] != lastColour) {
+        lastColour = climateMap[pix];
+        paletteID = paletteIDs.at(lastColour);
       }
+      statistics.climateHistograms[ID * palette.size() + paletteID]++;
+    }
+  });
+  auto &histograms = provinceTable.climateHistograms;
+  histograms.assign(provinceTable.size() * palette.size(), 0);
+  for (const auto &statistics : bandStatistics) {
+    for (auto ID = 0; ID < provinceTable.size(); ID++) {
+      provinceTable.areas[ID] += statistics.areas[ID];
+      provinceTable.cityPixels[ID] += statistics.cityPixels[ID];
+    }
+    for (auto i = 0; i < histograms.size(); i++)
+      histograms[i] += statistics.climateHistograms[i];
+  }
+  // single pixel samples
+  for (auto ID = 0; ID < provinceTable.size(); ID++) {
+    const auto baseProvince = provinceTable.baseProvinces[ID];
+    provinceTable.populationSamples[ID] =
+        popMap[baseProvince->position.weightedCenter] / populationColour;
+    if (baseProvince->cityPixels.size())
+      provinceTable.cityDensities[ID] =
+          cityMap[baseProvince->cityPixels[0]] / cityColour;
+  }
+}
+
+void Generator::generatePopulations() {
+  Tracing::ScopedTimer timer("generatePopulations");
+  Logging::logLine("Generating Population");
+  for (auto ID = 0; ID < provinceTable.size(); ID++) {
+    if (provinceTable.owners[ID] == -1)
+      continue;
+    // calculate the population factor
+    provinceTable.popFactors[ID] = 0.1 + provinceTable.populationSamples[ID];
+    // calculate share of province that is a city
+    provinceTable.cityShares[ID] =
+        (double)provinceTable.cityPixels[ID] / provinceTable.areas[ID];
+  }
 }
 
 void Generator::generateDevelopment() {
+  Tracing::ScopedTimer timer("generateDevelopment");
   // high pop-> high development
   // high city share->high dev
   // terrain type?
   // .....
   Logging::logLine("Generating State Development");
-  auto &config = Fwg::Cfg::Values();
-  const auto &cityMap = fwg.cityMap;
-  for (auto &c : countries)
-    for (auto &gR : c.second.ownedRegions)
-      for (auto &gameProv : gameRegions[gR].gameProvinces) {
-        auto cityDensity = 0.0;
-        // calculate development with density of city and population factor
-        if (gameProv.baseProvince->cityPixels.size())
-          cityDensity = cityMap[gameProv.baseProvince->cityPixels[0]] /
-              config.colours["cities"];
-        gameProv.devFactor =
-            std::clamp(0.2 + 0.5 * gameProv.popFactor +
-                           1.0 * gameProv.cityShare * cityDensity,
-                       0.0, 1.0);
-      }
+  for (auto ID = 0; ID < provinceTable.size(); ID++) {
+    if (provinceTable.owners[ID] == -1)
+      continue;
+    // calculate development with density of city and population factor
+    provinceTable.devFactors[ID] =
+        std::clamp(0.2 + 0.5 * provinceTable.popFactors[ID] +
+                       1.0 * provinceTable.cityShares[ID] *
+                           provinceTable.cityDensities[ID],
+                   0.0, 1.0);
+  }
 }
 
 void Generator::mapTerrain() {
+  Tracing::ScopedTimer timer("mapTerrain");
   auto &config = Fwg::Cfg::Values();
   const auto &colours = config.colours;
-  const auto &climateMap = fwg.climateMap;
-  Bitmap typeMap(climateMap.bInfoHeader.biWidth,
-                 climateMap.bInfoHeader.biHeight, 24);
   Logging::logLine("Mapping Terrain");
-  std::vector<std::string> targetTypes{"plains",   "forest", "marsh", "hills",
-                                       "mountain", "desert", "urban", "jungle"};
-
-  for (auto &c : countries)
-    for (auto &gameRegion : c.second.ownedRegions)
-      for (auto &gameProv : gameRegions[gameRegion].gameProvinces) {
-        std::map<Fwg::Gfx::Colour, int> colourPrevalence;
-        for (auto &pix : gameProv.baseProvince->pixels) {
-          if (colourPrevalence[climateMap[pix]])
-            colourPrevalence[climateMap[pix]]++;
-          else
-            colourPrevalence[climateMap[pix]] = 1;
-        }
-        // find the most prevalent colour in province, which sets the terrain
-        // type
-        using pair_type = decltype(colourPrevalence)::value_type;
-        auto pr = std::max_element(
-            std::begin(colourPrevalence), std::end(colourPrevalence),
-            [](const pair_type &p1, const pair_type &p2) {
-              return p1.second < p2.second;
-            });
-        // now check which it is and set the terrain type
-        if (pr->first == colours.at("jungle"))
-          gameProv.terrainType = "jungle";
-        else if (pr->first == colours.at("forest"))
-          gameProv.terrainType = "forest";
-        else if (pr->first == colours.at("hills"))
-          gameProv.terrainType = "hills";
-        else if (pr->first == colours.at("mountains") ||
-                 pr->first == colours.at("peaks"))
-          gameProv.terrainType = "mountain";
-        else if (pr->first == colours.at("grassland") ||
-                 pr->first == colours.at("savannah"))
-          gameProv.terrainType = "plains";
-        else if (pr->first == colours.at("desert"))
-          gameProv.terrainType = "desert";
-        else
-          gameProv.terrainType = "plains";
-        gameProvinces[gameProv.ID].terrainType = gameProv.terrainType;
-        for (auto pix : gameProv.baseProvince->pixels) {
-          if (pr->first == colours.at("jungle"))
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{255, 255, 0});
-          else if (pr->first == colours.at("forest"))
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{0, 255, 0});
-          else if (pr->first == colours.at("hills"))
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{128, 128, 128});
-          else if (pr->first == colours.at("mountains") ||
-                   pr->first == colours.at("peaks"))
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{255, 255, 255});
-          else if (pr->first == colours.at("grassland") ||
-                   pr->first == colours.at("savannah"))
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{0, 255, 128});
-          else if (pr->first == colours.at("desert"))
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{0, 255, 255});
-          else
-            typeMap.setColourAtIndex(pix, Fwg::Gfx::Colour{255, 0, 0});
-        }
-      }
-  Bmp::save(typeMap, "Maps/typeMap.bmp");
+  // the climate histograms come from gatherProvinceStatistics
+  const auto &palette = provinceTable.climatePalette;
+  const auto &histograms = provinceTable.climateHistograms;
+  const auto paletteSize = palette.size();
+  // resolve every palette colour once into a terrain class, which sets the
+  // terrain type and the colour of the type map
+  struct TerrainClass {
+    std::string terrainType;
+    Fwg::Gfx::Colour typeColour;
+  };
+  const std::vector<TerrainClass> terrainClasses{
+      {"jungle", {255, 255, 0}},  {"forest", {0, 255, 0}},
+      {"hills", {128, 128, 128}}, {"mountain", {255, 255, 255}},
+      {"plains", {0, 255, 128}},  {"desert", {0, 255, 255}},
+      {"plains", {255, 0, 0}}};
+  std::vector<int> paletteClasses;
+  for (const auto &colour : palette) {
+    if (colour == colours.at("jungle"))
+      paletteClasses.push_back(0);
+    else if (colour == colours.at("forest"))
+      paletteClasses.push_back(1);
+    else if (colour == colours.at("hills"))
+      paletteClasses.push_back(2);
+    else if (colour == colours.at("mountains") ||
+             colour == colours.at("peaks"))
+      paletteClasses.push_back(3);
+    else if (colour == colours.at("grassland") ||
+             colour == colours.at("savannah"))
+      paletteClasses.push_back(4);
+    else if (colour == colours.at("desert"))
+      paletteClasses.push_back(5);
+    else
+      paletteClasses.push_back(6);
+  }
+  // the colour the type map shows for each owned province
+  std::vector<Fwg::Gfx::Colour> typeColours(provinceTable.size());
+  for (auto ID = 0; ID < provinceTable.size(); ID++) {
+    if (provinceTable.owners[ID] == -1)
+      continue;
+    // find the most prevalent colour in province, the first one on ties
+    auto prevalentID = 0;
+    for (auto paletteID = 1; paletteID < paletteSize; paletteID++)
+      if (histograms[ID * paletteSize + paletteID] >
+          histograms[ID * paletteSize + prevalentID])
+        prevalentID = paletteID;
+    const auto &terrainClass = terrainClasses[paletteClasses[prevalentID]];
+    provinceTable.setTerrainType(ID, terrainClass.terrainType);
+    typeColours[ID] = terrainClass.typeColour;
+  }
+  if (DebugMaps::enabled())
+    DebugMaps::save("Maps/typeMap.bmp", [width = labels.width,
+                                         height = labels.height,
+                                         provinceLabels = labels.provinces,
+                                         typeColours = std::move(typeColours)] {
+      Bitmap typeMap(width, height, 24);
+      for (auto pix = 0; pix < provinceLabels.size(); pix++)
+        if (provinceLabels[pix] != LabelRasters::none)
+          typeMap.imageData[pix] = typeColours[provinceLabels[pix]];
+      return typeMap;
+    });
 }
 
 Region &Generator::findStartRegion() {
-  std::vector<Region> freeRegions;
-  for (const auto &gameRegion : gameRegions)
-    if (!gameRegion.assigned && !gameRegion.sea)
-      freeRegions.push_back(gameRegion);
-
-  if (freeRegions.size() == 0)
+  if (freeRegions.empty())
     return gameRegions[0];
-
-  const auto &startRegion = Fwg::Utils::selectRandom(freeRegions);
-  return gameRegions[startRegion.ID];
+  return gameRegions[freeRegions.random()];
 }
 
 // generate countries according to given ruleset for each game
 // TODO: rulesets, e.g. naming schemes? tags? country size?
-void Generator::generateCountries(int numCountries,
+void Generator::generateCountries(int numCountries, int regionsPerCountry,
                                   const std::string &gamePath) {
-  auto &config = Fwg::Cfg::Values();
+  Tracing::ScopedTimer timer("generateCountries");
   this->numCountries = numCountries;
   Logging::logLine("Generating Countries");
   // load tags from hoi4 that are used by the base game
@@ -210,49 +310,165 @@ void Generator::generateCountries(int numCountries,
 
   for (int i = 0; i < numCountries; i++) {
     auto name { NameGeneration::generateName(nData)};
-    PdoxCountry pdoxC(NameGeneration::generateTag(name, nData), i, name,
+    PdoxCountry pdoxC(NameGeneration::generateTag(name, nData),
+                      (int)countries.size(), name,
                       NameGeneration::generateAdjective(name, nData),
-                      Gfx::Flag(82, 52));
+                      (int)countries.size());
     // randomly set development of countries
     pdoxC.developmentFactor = RandNum::getRandom(0.1, 1.0);
-    countries.emplace(pdoxC.tag, pdoxC);
+    // a tag can only be used once
+    if (!countryIDs.emplace(packTag(pdoxC.tag), pdoxC.ID).second)
+      continue;
+    countries.push_back(pdoxC);
   }
+  // flags are drawn from their own streams, so they don't need to be
+  // generated in the order of the countries
+  flagAtlas.generate((int)countries.size(),
+                     (std::uint32_t)Fwg::Cfg::Values().seed, numThreads);
+  freeRegions.build(gameRegions);
+  countryAdjacency.reset((int)countries.size());
   for (auto &pdoxCountry : countries) {
-    auto startRegion(findStartRegion());
+    auto &startRegion = findStartRegion();
     if (startRegion.assigned || startRegion.sea)
       continue;
-    pdoxCountry.second.assignRegions(6, gameRegions, startRegion,
-                                     gameProvinces);
+    assignRegion(startRegion, pdoxCountry);
+  }
+  growCountries(regionsPerCountry);
+  assignLeftoverRegions();
+  labelCountries();
+}
+
+void Generator::growCountries(int regionsPerCountry) {
+  Tracing::ScopedTimer timer("growCountries");
+  // a free region next to a country. Countries with fewer regions come first,
+  // the random tie break keeps equally sized countries from growing in ID
+  // order
+  struct Candidate {
+    int size;
+    double tieBreak;
+    CountryId country;
+    int regionID;
+    bool operator>(const Candidate &right) const {
+      return std::tie(size, tieBreak) > std::tie(right.size, right.tieBreak);
+    }
+  };
+  std::priority_queue<Candidate, std::vector<Candidate>,
+                      std::greater<Candidate>>
+      candidates;
+  // every country draws its tie breaks from its own stream
+  std::vector<RandomStream> tieBreaks;
+  for (const auto &country : countries)
+    tieBreaks.push_back(
+        {(std::uint32_t)Fwg::Cfg::Values().seed, "growCountries",
+         (std::uint32_t)country.ID});
+  const auto addCandidates = [&](const PdoxCountry &country,
+                                 const Region &region) {
+    for (const auto neighbourID : region.neighbours)
+      if (freeRegions.contains(neighbourID))
+        candidates.push({(int)country.ownedRegions.size(),
+                         tieBreaks[country.ID].getRandom(0.0, 1.0), country.ID,
+                         neighbourID});
+  };
+  for (const auto &country : countries)
+    for (const auto &regionID : country.ownedRegions)
+      addCandidates(country, gameRegions[regionID]);
+  while (candidates.size()) {
+    auto candidate = candidates.top();
+    candidates.pop();
+    auto &country = countries[candidate.country];
+    const auto size = (int)country.ownedRegions.size();
+    if (!freeRegions.contains(candidate.regionID) || size >= regionsPerCountry)
+      continue;
+    // the country grew since this candidate was queued, queue it again at its
+    // current size
+    if (candidate.size != size) {
+      candidate.size = size;
+      candidates.push(candidate);
+      continue;
+    }
+    auto &region = gameRegions[candidate.regionID];
+    assignRegion(region, country);
+    addCandidates(country, region);
   }
+}
+
+void Generator::assignLeftoverRegions() {
+  Tracing::ScopedTimer timer("assignLeftoverRegions");
+  auto &config = Fwg::Cfg::Values();
+  // flood outwards from all owned land at once. Every free land region goes
+  // to the country whose flood reaches it first. The flood starts in region ID
+  // order and follows the adjacency order, so it only depends on the seeding
+  std::deque<int> frontier;
+  const auto flood = [&]() {
+    while (frontier.size()) {
+      const auto &source = gameRegions[frontier.front()];
+      frontier.pop_front();
+      for (const auto neighbourID : source.neighbours) {
+        auto &neighbour = gameRegions[neighbourID];
+        if (neighbour.sea || neighbour.assigned)
+          continue;
+        assignRegion(neighbour, countries.at(source.owner));
+        frontier.push_back(neighbourID);
+      }
+    }
+  };
+  for (const auto &gameRegion : gameRegions)
+    if (!gameRegion.sea && gameRegion.assigned)
+      frontier.push_back(gameRegion.ID);
+  flood();
+  // land the flood can't reach over land, e.g. islands, joins the nearest
+  // owned land and floods from there
   for (auto &gameRegion : gameRegions) {
     if (!gameRegion.sea && !gameRegion.assigned) {
       auto &gR = Fwg::Utils::getNearestAssignedLand(
           gameRegions, gameRegion, config.width, config.height);
-      countries.at(gR.owner).addRegion(gameRegion, gameRegions, gameProvinces);
+      assignRegion(gameRegion, countries.at(gR.owner));
+      frontier.push_back(gameRegion.ID);
+      flood();
     }
   }
 }
 
+void Generator::assignRegion(Region &region, PdoxCountry &country) {
+  const auto previousOwner = region.owner;
+  country.addRegion(region, gameRegions, provinceTable, freeRegions);
+  countryAdjacency.changeOwner(gameRegions, region, previousOwner);
+}
+
 void Generator::evaluateNeighbours() {
+  Tracing::ScopedTimer timer("evaluateNeighbours");
   Logging::logLine("Evaluating Country Neighbours");
+  // the adjacency is already up to date, the countries keep a copy of their
+  // row
   for (auto &c : countries)
-    for (const auto &gR : c.second.ownedRegions)
-      for (const auto &neighbourRegion : gameRegions[gR].neighbours)
-        if (gameRegions[neighbourRegion].owner != c.first)
-          c.second.neighbours.insert(gameRegions[neighbourRegion].owner);
+    c.neighbours = countryAdjacency.row(c.ID);
 }
 
-Bitmap Generator::dumpDebugCountrymap(const std::string &path) {
-  Logging::logLine("Mapping Continents");
-  auto &config = Fwg::Cfg::Values();
-  Bitmap countryBMP(config.width, config.height, 24);
+CountryId Generator::countryID(const std::string &tag) const {
+  const auto country = countryIDs.find(packTag(tag));
+  if (country == countryIDs.end())
+    throw(std::exception(("Unknown country tag " + tag).c_str()));
+  return country->second;
+}
+
+std::function<Bitmap()> Generator::countryMapRenderer() const {
+  std::vector<Fwg::Gfx::Colour> colours;
   for (const auto &country : countries)
-    for (const auto &region : country.second.ownedRegions)
-      for (const auto &prov : gameRegions[region].provinces)
-        for (const auto &pix : prov->pixels)
-          countryBMP.setColourAtIndex(pix, country.second.colour);
+    colours.push_back(country.colour);
+  return [width = labels.width, height = labels.height,
+          countryLabels = labels.countries, colours] {
+    Bitmap countryBMP(width, height, 24);
+    for (auto pix = 0; pix < countryLabels.size(); pix++)
+      if (countryLabels[pix] != LabelRasters::none)
+        countryBMP.imageData[pix] = colours[countryLabels[pix]];
+    return countryBMP;
+  };
+}
 
-  Bmp::save(countryBMP, (path).c_str());
-  return countryBMP;
+void Generator::dumpDebugCountrymap(const std::string &path) {
+  Tracing::ScopedTimer timer("dumpDebugCountrymap");
+  Logging::logLine("Mapping Continents");
+  if (DebugMaps::enabled())
+    DebugMaps::save(path, countryMapRenderer());
 }
 } // namespace Scenario
\ No newline at end of file
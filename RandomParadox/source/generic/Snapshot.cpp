@@ -0,0 +1,49 @@
+#include "generic/Snapshot.h"
+namespace Scenario::Snapshot {
+Writer::Writer(const std::string &path, const std::string &type)
+    : file(path, std::ios::binary) {
+  if (!file)
+    throw(std::exception(("Could not open snapshot " + path).c_str()));
+  write(magic);
+  write(type);
+  write(version);
+}
+
+Writer::~Writer() {}
+
+void Writer::write(const std::string &value) {
+  write(value.size());
+  file.write(value.data(), value.size());
+}
+
+Reader::Reader(const std::string &path, const std::string &type)
+    : file(path, std::ios::binary) {
+  if (!file)
+    throw(std::exception(("Could not open snapshot " + path).c_str()));
+  if (get<unsigned int>() != magic)
+    throw(std::exception(("File " + path + " is no snapshot").c_str()));
+  std::string fileType;
+  unsigned int fileVersion;
+  read(fileType);
+  read(fileVersion);
+  if (fileType != type || fileVersion != version)
+    throw(std::exception(("Snapshot " + path + " is no " + type +
+                          " snapshot of version " + std::to_string(version))
+                             .c_str()));
+}
+
+Reader::~Reader() {}
+
+void Reader::check() {
+  if (!file)
+    throw(std::exception("Snapshot ended unexpectedly"));
+}
+
+void Reader::read(std::string &value) {
+  size_t size;
+  read(size);
+  value.resize(size);
+  file.read(value.data(), size);
+  check();
+}
+} // namespace Scenario::Snapshot
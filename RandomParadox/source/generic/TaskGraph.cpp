@@ -0,0 +1,112 @@
+#include "generic/TaskGraph.h"
+#include "generic/Tracing.h"
+#include <algorithm>
+#include <thread>
+namespace Scenario {
+TaskGraph::TaskGraph(const unsigned int numThreads) : numThreads(numThreads) {
+  if (!this->numThreads)
+    this->numThreads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+TaskGraph::~TaskGraph() {}
+
+int TaskGraph::add(const std::string &name, std::function<void()> work,
+                   const std::vector<int> &dependencies) {
+  const int ID = (int)tasks.size();
+  tasks.push_back({name, work, {}, 0});
+  for (const auto dependency : dependencies) {
+    if (dependency < 0 || dependency >= ID)
+      throw(std::exception(
+          ("Task " + name + " depends on a task that was not added before")
+              .c_str()));
+    tasks[dependency].dependants.push_back(ID);
+    tasks[ID].openDependencies++;
+  }
+  return ID;
+}
+
+void TaskGraph::work() {
+  const auto startAllocations = Memory::getAllocations();
+  while (true) {
+    int ID;
+    {
+      std::unique_lock<std::mutex> lock(taskMutex);
+      taskCondition.wait(lock, [this] {
+        return readyTasks.size() || finishedTasks == tasks.size() ||
+               firstError;
+      });
+      // stop taking tasks when done or when one of the tasks failed
+      if (finishedTasks == tasks.size() || firstError)
+        break;
+      ID = readyTasks.front();
+      readyTasks.pop_front();
+    }
+    try {
+      Tracing::ScopedTimer timer(tasks[ID].name);
+      tasks[ID].work();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(taskMutex);
+      if (!firstError)
+        firstError = std::current_exception();
+      taskCondition.notify_all();
+      break;
+    }
+    std::lock_guard<std::mutex> lock(taskMutex);
+    finishedTasks++;
+    // release every task that only waited for this one
+    for (const auto dependant : tasks[ID].dependants)
+      if (--tasks[dependant].openDependencies == 0)
+        readyTasks.push_back(dependant);
+    taskCondition.notify_all();
+  }
+  // hand the allocations of this worker to the thread that runs the graph
+  const auto endAllocations = Memory::getAllocations();
+  std::lock_guard<std::mutex> lock(taskMutex);
+  workerAllocations.count += endAllocations.count - startAllocations.count;
+  workerAllocations.bytes += endAllocations.bytes - startAllocations.bytes;
+}
+
+void TaskGraph::run() {
+  // dependencies always point to earlier tasks, so the order of insertion is
+  // a valid order for a single thread
+  if (numThreads == 1) {
+    for (auto &task : tasks) {
+      Tracing::ScopedTimer timer(task.name);
+      task.work();
+    }
+    return;
+  }
+  Tracing::logLine("Running ", tasks.size(), " tasks on ", numThreads,
+                   " threads");
+  for (auto i = 0; i < tasks.size(); i++)
+    if (!tasks[i].openDependencies)
+      readyTasks.push_back(i);
+  std::vector<std::thread> workers;
+  for (auto i = 0u; i < std::min<size_t>(numThreads, tasks.size()); i++)
+    workers.push_back(std::thread(&TaskGraph::work, this));
+  for (auto &worker : workers)
+    worker.join();
+  Memory::addAllocations(workerAllocations);
+  if (firstError)
+    std::rethrow_exception(firstError);
+}
+
+int TaskGraph::chunkCount(const int count, const unsigned int numThreads) {
+  const auto threads = numThreads
+                           ? numThreads
+                           : std::max(1u, std::thread::hardware_concurrency());
+  return std::max(1, std::min(count, (int)threads));
+}
+
+void TaskGraph::parallelFor(
+    const std::string &name, const int count, const unsigned int numThreads,
+    const std::function<void(int chunk, int first, int end)> &work) {
+  const auto chunks = chunkCount(count, numThreads);
+  TaskGraph graph(chunks);
+  for (auto chunk = 0; chunk < chunks; chunk++)
+    graph.add(name, [&, chunk] {
+      work(chunk, chunk * count / chunks, (chunk + 1) * count / chunks);
+    });
+  graph.run();
+}
+} // namespace Scenario
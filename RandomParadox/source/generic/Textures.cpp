@@ -1,4 +1,5 @@
 #include "generic/Textures.h"
+#include "generic/Tracing.h"
 
 using namespace DirectX;
 namespace Scenario::Gfx::Textures {
@@ -9,6 +10,7 @@ void writeDDS(const int width, const int height,
   Image image(width, height, format, sizeof(uint8_t) * width * 4,
               sizeof(uint8_t) * width * height, pixelData.data());
   SaveToDDSFile(image, DDS_FLAGS_NONE, wPath.c_str());
+  Tracing::addFileBytes(path);
 }
 
 void writeTGA(const int width, const int height,
@@ -18,6 +20,7 @@ void writeTGA(const int width, const int height,
               sizeof(uint8_t) * width * 4, sizeof(uint8_t) * width * height,
               pixelData.data());
   SaveToTGAFile(image, TGA_FLAGS_NONE, wPath.c_str());
+  Tracing::addFileBytes(path);
 }
 
 std::vector<uint8_t> readTGA(const std::string &path) {
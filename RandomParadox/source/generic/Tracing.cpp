@@ -0,0 +1,112 @@
+#include "generic/Tracing.h"
+#include "generic/ParserUtils.h"
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+namespace Scenario::Tracing {
+struct Event {
+  std::string name;
+  int threadID;
+  long long start;
+  long long duration;
+  unsigned long long bytes;
+  Memory::Usage startMemory;
+  Memory::Usage endMemory;
+  Memory::Allocations allocations;
+};
+static const auto traceStart = std::chrono::steady_clock::now();
+static std::mutex eventMutex;
+static std::vector<Event> events;
+static std::atomic<int> threadCounter = 0;
+// small sequential IDs read better in the trace viewer than hashed thread ids
+static thread_local const int threadID = threadCounter++;
+static thread_local ScopedTimer *currentScope = nullptr;
+
+static long long microseconds(const std::chrono::steady_clock::time_point &t) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(t - traceStart)
+      .count();
+}
+
+ScopedTimer::ScopedTimer(const std::string &name)
+    : name{name}, start{std::chrono::steady_clock::now()},
+      startMemory{Memory::getUsage()},
+      startAllocations{Memory::getAllocations()}, parent{currentScope} {
+  currentScope = this;
+}
+
+ScopedTimer::~ScopedTimer() {
+  const auto end = std::chrono::steady_clock::now();
+  const auto endMemory = Memory::getUsage();
+  const auto endAllocations = Memory::getAllocations();
+  currentScope = parent;
+  if (parent != nullptr)
+    parent->bytes += bytes;
+  std::lock_guard<std::mutex> lock(eventMutex);
+  events.push_back({name,
+                    threadID,
+                    microseconds(start),
+                    microseconds(end) - microseconds(start),
+                    bytes,
+                    startMemory,
+                    endMemory,
+                    {endAllocations.count - startAllocations.count,
+                     endAllocations.bytes - startAllocations.bytes}});
+}
+
+void addBytes(const unsigned long long bytes) {
+  if (currentScope != nullptr)
+    currentScope->bytes += bytes;
+}
+
+void addFileBytes(const std::string &path) {
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (!error)
+    addBytes(size);
+}
+
+void writeTrace(const std::string &path) {
+  std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    for (auto i = 0; i < events.size(); i++) {
+      const auto &event = events[i];
+      if (i)
+        trace += ",";
+      trace += "\n{\"name\":\"" + event.name +
+               "\",\"ph\":\"X\",\"pid\":1,\"tid\":" +
+               std::to_string(event.threadID) +
+               ",\"ts\":" + std::to_string(event.start) +
+               ",\"dur\":" + std::to_string(event.duration) +
+               ",\"args\":{\"bytes\":" + std::to_string(event.bytes) +
+               ",\"rssStart\":" + std::to_string(event.startMemory.current) +
+               ",\"rssEnd\":" + std::to_string(event.endMemory.current) +
+               ",\"peakRss\":" + std::to_string(event.endMemory.peak) +
+               ",\"peakIncrease\":" +
+               std::to_string(event.endMemory.peak - event.startMemory.peak) +
+               ",\"allocations\":" + std::to_string(event.allocations.count) +
+               ",\"allocatedBytes\":" +
+               std::to_string(event.allocations.bytes) + "}}";
+      // counter events draw the memory usage as a graph below the stages
+      trace += ",\n{\"name\":\"memory\",\"ph\":\"C\",\"pid\":1,\"ts\":" +
+               std::to_string(event.start + event.duration) +
+               ",\"args\":{\"rss\":" +
+               std::to_string(event.endMemory.current) +
+               ",\"peakRss\":" + std::to_string(event.endMemory.peak) + "}}";
+    }
+  }
+  trace += "\n]}\n";
+  ParserUtils::writeFile(path, trace);
+}
+
+std::mutex &logMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+void clearTrace() {
+  std::lock_guard<std::mutex> lock(eventMutex);
+  events.clear();
+}
+} // namespace Scenario::Tracing
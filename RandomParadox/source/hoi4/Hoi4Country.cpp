@@ -3,15 +3,10 @@
 namespace Scenario::Hoi4 {
 Hoi4Country::Hoi4Country() {}
 
-Hoi4Country::Hoi4Country(PdoxCountry &c,
-                         std::vector<Scenario::Region> &gameRegions)
+Hoi4Country::Hoi4Country(PdoxCountry &c)
     : PdoxCountry(c), allowElections{true}, bully{0.0},
       relativeScore{0.0}, parties{25, 25, 25, 25},
-       strengthScore{0} {
-  for (auto &region : c.ownedRegions) {
-    hoi4Regions.push_back(gameRegions[region]);
-  }
-}
+       strengthScore{0} {}
 
 Hoi4Country::~Hoi4Country() {}
 
@@ -2,17 +2,19 @@
 using namespace Fwg;
 using namespace Fwg::Gfx;
 namespace Scenario::Hoi4 {
+std::vector<std::vector<std::vector<std::string>>> Generator::focusChains;
 Generator::Generator() {}
-Generator::Generator(FastWorldGenerator &fwg) : Scenario::Generator(fwg) {
-  nData = NameGeneration::prepare("resources\\names");
-}
+Generator::Generator(std::shared_ptr<FastWorldGenerator> fwg)
+    : Scenario::Generator(fwg) {}
 
 Generator::~Generator() {}
 
 void Generator::generateStateResources() {
+  Tracing::ScopedTimer timer("generateStateResources");
   Utils::Logging::logLine("HOI4: Digging for resources");
   for (auto &c : hoi4Countries) {
-    for (auto &hoi4Region : c.second.hoi4Regions) {
+    for (const auto &regionID : c.ownedRegions) {
+      auto &hoi4Region = hoi4Regions[regionID];
       for (const auto &resource : resources) {
         auto chance = resource.second[2];
         if (RandNum::getRandom(100)< chance * 100.0) {
@@ -37,30 +39,34 @@ void Generator::generateStateResources() {
 }
 
 void Generator::generateStateSpecifics(const int regionAmount) {
+  Tracing::ScopedTimer timer("generateStateSpecifics");
   Utils::Logging::logLine("HOI4: Planning the economy");
   auto &config = Cfg::Values();
   // calculate the target industry amount
   auto targetWorldIndustry = 1248 * sizeFactor * industryFactor;
   Utils::Logging::logLine(config.landPercentage);
+  auto &navalBaseLevels =
+      provinceTable.doubleAttributes[ProvinceTable::navalBases];
   for (auto &c : hoi4Countries) {
-    for (auto &hoi4Region : c.second.hoi4Regions) {
+    for (const auto &regionID : c.ownedRegions) {
+      auto &hoi4Region = hoi4Regions[regionID];
       // count the number of land states for resource generation
       landStates++;
       double totalStateArea = 0;
       double totalDevFactor = 0;
       double totalPopFactor = 0;
-      for (const auto &gameProv : hoi4Region.gameProvinces) {
-        totalDevFactor +=
-            gameProv.devFactor / (double)hoi4Region.gameProvinces.size();
-        totalPopFactor +=
-            gameProv.popFactor / (double)hoi4Region.gameProvinces.size();
-        totalStateArea += gameProv.baseProvince->pixels.size();
+      for (const auto &prov : hoi4Region.provinces) {
+        totalDevFactor += provinceTable.devFactors[prov->ID] /
+                          (double)hoi4Region.provinces.size();
+        totalPopFactor += provinceTable.popFactors[prov->ID] /
+                          (double)hoi4Region.provinces.size();
+        totalStateArea += prov->pixels.size();
       }
       // state level is calculated from population and development
       hoi4Region.stateCategory =
           std::clamp((int)(totalPopFactor * 5.0 + totalDevFactor * 6.0), 0, 9);
       // one province region? Must be an island state
-      if (hoi4Region.gameProvinces.size() == 1) {
+      if (hoi4Region.provinces.size() == 1) {
         hoi4Region.stateCategory = 1;
       }
       hoi4Region.development = totalDevFactor;
@@ -69,16 +75,15 @@ void Generator::generateStateSpecifics(const int regionAmount) {
       worldPop += (long long)hoi4Region.population;
       // count the total coastal provinces of this region
       auto totalCoastal = 0;
-      for (auto &gameProv : hoi4Region.gameProvinces) {
-        if (gameProv.baseProvince->coastal) {
+      for (const auto &prov : hoi4Region.provinces) {
+        if (prov->coastal) {
           totalCoastal++;
           // only create a naval base, if a coastal supply hub was determined in
           // this province
-          if (gameProv.attributeDoubles["naval_bases"] == 1)
-            gameProv.attributeDoubles["naval_bases"] =
-                RandNum::getRandom(1, 5);
+          if (navalBaseLevels[prov->ID] == 1)
+            navalBaseLevels[prov->ID] = RandNum::getRandom(1, 5);
         } else {
-          gameProv.attributeDoubles["naval_bases"] = 0;
+          navalBaseLevels[prov->ID] = 0;
         }
       }
       // calculate total industry in this state
@@ -110,6 +115,7 @@ void Generator::generateStateSpecifics(const int regionAmount) {
 }
 
 void Generator::generateCountrySpecifics() {
+  Tracing::ScopedTimer timer("generateCountrySpecifics");
   Utils::Logging::logLine("HOI4: Choosing uniforms and electing Tyrants");
   sizeFactor = sqrt((double)(Cfg::Values().width * Cfg::Values().height) /
                     (double)(5632 * 2048));
@@ -128,10 +134,14 @@ void Generator::generateCountrySpecifics() {
       "southamerican",    "commonwealth",     "asian"};
   std::vector<std::string> ideologies{"fascism", "democratic", "communism",
                                       "neutrality"};
+  // every region becomes a state once, the countries only keep their IDs
+  hoi4Regions.clear();
+  for (const auto &gameRegion : gameRegions)
+    hoi4Regions.push_back(gameRegion);
   for (auto &country : countries) {
     // construct a hoi4country with country from ScenarioGenerator.
     // We want a copy here
-    Hoi4Country hC(country.second, gameRegions);
+    Hoi4Country hC(country);
 
     // select a random country ideology
     hC.gfxCulture = Utils::selectRandom(gfxCultures);
@@ -164,12 +174,13 @@ void Generator::generateCountrySpecifics() {
       hC.allowElections = 0;
     // now get the full name of the country
     hC.fullName = NameGeneration::modifyWithIdeology(
-        hC.rulingParty, country.second.name, country.second.adjective, nData);
-    hoi4Countries.insert({hC.tag, hC});
+        hC.rulingParty, country.name, country.adjective, nData);
+    hoi4Countries.push_back(hC);
   }
 }
 
 void Generator::generateStrategicRegions() {
+  Tracing::ScopedTimer timer("generateStrategicRegions");
   Utils::Logging::logLine("HOI4: Dividing world into strategic regions");
   std::set<int> assignedIdeas;
   for (auto &region : gameRegions) {
@@ -192,37 +203,45 @@ void Generator::generateStrategicRegions() {
       strategicRegions.push_back(sR);
     }
   }
-  Bitmap stratRegionBMP(Cfg::Values().width, Cfg::Values().height, 24);
+  Bitmap stratRegionBMP(labels.width, labels.height, 24);
+  // the colour of each region, painted in one sweep over the region raster
+  std::vector<Colour> regionColours(gameRegions.size());
   for (auto &strat : strategicRegions) {
     Colour c{static_cast<unsigned char>(RandNum::getRandom(255)),
              static_cast<unsigned char>(RandNum::getRandom(255)),
              static_cast<unsigned char>(RandNum::getRandom(255))};
     for (auto &reg : strat.gameRegionIDs) {
       c.setBlue(gameRegions[reg].sea ? 255 : 0);
-      for (auto &prov : gameRegions[reg].gameProvinces) {
-        for (auto &pix : prov.baseProvince->pixels) {
-          stratRegionBMP.setColourAtIndex(pix, c);
-        }
-      }
+      regionColours[reg] = c;
     }
   }
+  labels.forEachBand([&](int, int firstRow, int endRow) {
+    for (auto pix = firstRow * labels.width; pix < endRow * labels.width;
+         pix++)
+      if (labels.regions[pix] != LabelRasters::none)
+        stratRegionBMP.imageData[pix] = regionColours[labels.regions[pix]];
+  });
   Bmp::bufferBitmap("strat", stratRegionBMP);
-  Bmp::save(stratRegionBMP, "Maps\\stratRegions.bmp");
+  // only the debug copy on disk is written in the background
+  if (DebugMaps::enabled())
+    DebugMaps::save("Maps\\stratRegions.bmp",
+                    [stratRegionBMP] { return stratRegionBMP; });
 }
 
 void Generator::generateWeather() {
+  Tracing::ScopedTimer timer("generateWeather");
   for (auto &strat : strategicRegions) {
     for (auto &reg : strat.gameRegionIDs) {
       for (auto i = 0; i < 12; i++) {
         double averageTemperature = 0.0;
         double averageDeviation = 0.0;
         double averagePrecipitation = 0.0;
-        for (auto &prov : gameRegions[reg].gameProvinces) {
-          averageDeviation += prov.baseProvince->weatherMonths[i][0];
-          averageTemperature += prov.baseProvince->weatherMonths[i][1];
-          averagePrecipitation += prov.baseProvince->weatherMonths[i][2];
+        for (const auto &prov : gameRegions[reg].provinces) {
+          averageDeviation += prov->weatherMonths[i][0];
+          averageTemperature += prov->weatherMonths[i][1];
+          averagePrecipitation += prov->weatherMonths[i][2];
         }
-        double divisor = (int)gameRegions[reg].gameProvinces.size();
+        double divisor = (int)gameRegions[reg].provinces.size();
         averageDeviation /= divisor;
         averageTemperature /= divisor;
         averagePrecipitation /= divisor;
@@ -269,69 +288,76 @@ void Generator::generateWeather() {
   }
 }
 
-void Generator::generateLogistics(Bitmap logistics) {
+void Generator::generateLogistics() {
+  Tracing::ScopedTimer timer("generateLogistics");
   Utils::Logging::logLine("HOI4: Building rail networks");
   auto width = Cfg::Values().width;
+  auto &navalBaseLevels =
+      provinceTable.doubleAttributes[ProvinceTable::navalBases];
+  // provinces the logistics map highlights
+  std::vector<int> capitalProvinceIDs;
+  std::vector<int> supplyHubProvinceIDs;
   for (auto &country : hoi4Countries) {
     // GameProvince ID, distance
     std::map<double, int> supplyHubs;
     // add capital
-    auto capitalPosition = gameRegions[country.second.capitalRegionID].position;
-    auto &capitalProvince = Utils::selectRandom(
-        gameRegions[country.second.capitalRegionID].gameProvinces);
+    auto capitalPosition = gameRegions[country.capitalRegionID].position;
+    const auto capitalProvince = Utils::selectRandom(
+        gameRegions[country.capitalRegionID].provinces);
     std::vector<double> distances;
-    // region ID, provinceID
-    std::map<int, GameProvince> supplyHubProvinces;
+    // province ID, province
+    std::map<int, const Fwg::Province *> supplyHubProvinces;
     std::map<int, bool> navalBases;
     std::set<int> gProvIDs;
-    for (auto &region : country.second.hoi4Regions) {
+    const auto &ownedRegions = country.ownedRegions;
+    for (const auto &regionID : ownedRegions) {
+      const auto &region = hoi4Regions[regionID];
       if ((region.stateCategory > 6 &&
-           region.ID != country.second.capitalRegionID)
+           region.ID != country.capitalRegionID)
           // if we're nearing the end of our region std::vector, and don't have
           // more than 25% of our regions as supply bases generate supply bases
           // for the last two regions
-          || (country.second.hoi4Regions.size() > 2 &&
-              (region.ID == (country.second.hoi4Regions.end() - 2)->ID) &&
-              supplyHubProvinces.size() <
-                  (country.second.hoi4Regions.size() / 4))) {
+          || (ownedRegions.size() > 2 &&
+              (region.ID == *(ownedRegions.end() - 2)) &&
+              supplyHubProvinces.size() < (ownedRegions.size() / 4))) {
         // select a random gameprovince of the state
 
-        auto y{Utils::selectRandom(region.gameProvinces)};
-        for (auto &prov : region.gameProvinces) {
-          if (prov.baseProvince->coastal) {
+        auto y{Utils::selectRandom(region.provinces)};
+        for (const auto &prov : region.provinces) {
+          if (prov->coastal) {
             // if this is a coastal region, the supply hub is a naval base as
             // well
             y = prov;
-            prov.attributeDoubles["naval_bases"] = 1;
+            navalBaseLevels[prov->ID] = 1;
             break;
           }
         }
         // save the province under the provinces ID
-        supplyHubProvinces[y.ID] = y;
-        navalBases[y.ID] = y.baseProvince->coastal;
+        supplyHubProvinces[y->ID] = y;
+        navalBases[y->ID] = y->coastal;
         // get the distance between this supply hub and the capital
-        auto distance = Utils::getDistance(capitalPosition,
-                                           y.baseProvince->position, width);
+        auto distance =
+            Utils::getDistance(capitalPosition, y->position, width);
         // save the distance under the province ID
-        supplyHubs[distance] = y.ID;
+        supplyHubs[distance] = y->ID;
         // save the distance
         distances.push_back(distance); // save distances to ensure ordering
       }
-      for (auto &gProv : region.gameProvinces) {
-        gProvIDs.insert(gProv.ID);
+      for (const auto &prov : region.provinces) {
+        gProvIDs.insert(prov->ID);
       }
     }
     std::sort(distances.begin(), distances.end());
     for (const auto distance : distances) {
       std::vector<int> passthroughProvinceIDs;
       int attempts = 0;
-      auto sourceNodeID = capitalProvince.ID;
+      auto sourceNodeID = capitalProvince->ID;
       supplyNodeConnections.push_back({sourceNodeID});
       do {
         attempts++;
         // the region we want to connect to the source
         auto destNodeID = supplyHubs[distance];
-        if (sourceNodeID == capitalProvince.ID) {
+        if (sourceNodeID == capitalProvince->ID) {
           // we are at the start of the search
           // distance to capital
           auto tempDistance = distance;
@@ -369,14 +395,13 @@ void Generator::generateLogistics(Bitmap logistics) {
         double tempMinDistance = width;
         auto closestID = INT_MAX;
         // now check every sourceNode neighbour for distance to destinationNode
-        for (auto &neighbourGProvince :
-             gameProvinces[sourceNodeID].neighbours) {
+        for (const auto neighbourID : provinceTable.neighbours(sourceNodeID)) {
           // check if this belongs to us
-          if (gProvIDs.find(neighbourGProvince.ID) == gProvIDs.end())
+          if (gProvIDs.find(neighbourID) == gProvIDs.end())
             continue;
           bool cont = false;
           for (auto passThroughID : passthroughProvinceIDs) {
-            if (passThroughID == neighbourGProvince.ID)
+            if (passThroughID == neighbourID)
               cont = true;
           }
           if (cont)
@@ -384,10 +409,10 @@ void Generator::generateLogistics(Bitmap logistics) {
           // the distance to the sources neighbours
           auto nodeDistance = Utils::getDistance(
               gameProvinces[destNodeID].baseProvince->position,
-              neighbourGProvince.baseProvince->position, width);
+              provinceTable.baseProvinces[neighbourID]->position, width);
           if (nodeDistance < tempMinDistance) {
             tempMinDistance = nodeDistance;
-            closestID = neighbourGProvince.ID;
+            closestID = neighbourID;
           }
         }
         if (closestID != INT_MAX) {
@@ -416,50 +441,67 @@ void Generator::generateLogistics(Bitmap logistics) {
         supplyNodeConnections.back().push_back(passState);
       }
     }
-    for (auto &pix : capitalProvince.baseProvince->pixels) {
-      logistics.setColourAtIndex(pix, {255, 255, 0});
-    }
-    for (auto &supplyHubProvince : supplyHubProvinces) {
-      for (auto &pix : supplyHubProvince.second.baseProvince->pixels) {
-        logistics.setColourAtIndex(pix, {0, 255, 0});
-      }
-    }
-  }
-  for (auto &connection : supplyNodeConnections) {
-    for (int i = 0; i < connection.size(); i++) {
-      for (auto pix : gameProvinces[connection[i]].baseProvince->pixels) {
-        // don't overwrite capitals and supply nodes
-        if (logistics[pix] == Colour{255, 255, 0} ||
-            logistics[pix] == Colour{0, 255, 0})
-          continue;
-        logistics.setColourAtIndex(pix, {255, 255, 255});
-      }
-    }
+    capitalProvinceIDs.push_back(capitalProvince->ID);
+    for (auto &supplyHubProvince : supplyHubProvinces)
+      supplyHubProvinceIDs.push_back(supplyHubProvince.first);
   }
-  Bmp::save(logistics, "Maps//logistics.bmp");
+  if (!DebugMaps::enabled())
+    return;
+  // the pixels of capitals, supply hubs and rail provinces, for the map
+  const auto collectSpans = [&](const std::vector<int> &provinceIDs) {
+    std::vector<PixelSpan> spans;
+    for (const auto ID : provinceIDs)
+      for (const auto &span : provinceTable.spans(ID))
+        spans.push_back(span);
+    return spans;
+  };
+  std::vector<int> railProvinceIDs;
+  for (const auto &connection : supplyNodeConnections)
+    railProvinceIDs.insert(railProvinceIDs.end(), connection.begin(),
+                           connection.end());
+  DebugMaps::save(
+      "Maps//logistics.bmp",
+      [countryMap = countryMapRenderer(),
+       capitalSpans = collectSpans(capitalProvinceIDs),
+       supplyHubSpans = collectSpans(supplyHubProvinceIDs),
+       railSpans = collectSpans(railProvinceIDs), width = provinceTable.width] {
+        auto logistics = countryMap();
+        fill(logistics, capitalSpans, {255, 255, 0});
+        fill(logistics, supplyHubSpans, {0, 255, 0});
+        forEachPixel(railSpans, width, [&](const int pix) {
+          // don't overwrite capitals and supply nodes
+          if (logistics[pix] == Colour{255, 255, 0} ||
+              logistics[pix] == Colour{0, 255, 0})
+            return;
+          logistics.setColourAtIndex(pix, {255, 255, 255});
+        });
+        return logistics;
+      });
 }
 
 void Generator::evaluateCountries() {
+  Tracing::ScopedTimer timer("evaluateCountries");
   Utils::Logging::logLine("HOI4: Evaluating Country Strength");
   double maxScore = 0.0;
   for (auto &c : hoi4Countries) {
     auto totalIndustry = 0.0;
     auto totalPop = 0.0;
     auto maxIndustryLevel = 0;
-    for (auto &ownedRegion : c.second.hoi4Regions) {
+    for (const auto &regionID : c.ownedRegions) {
+      const auto &ownedRegion = hoi4Regions[regionID];
       auto regionIndustry = ownedRegion.civilianFactories +
                             ownedRegion.dockyards + ownedRegion.armsFactories;
       // always make the most industrious region the capital
       if (regionIndustry > maxIndustryLevel)
-        c.second.capitalRegionID = ownedRegion.ID;
+        c.capitalRegionID = ownedRegion.ID;
       totalIndustry += regionIndustry;
       totalPop += (int)ownedRegion.population;
     }
     strengthScores[(int)(totalIndustry + totalPop / 1'000'000.0)].push_back(
-        c.first);
-    c.second.strengthScore = totalIndustry + totalPop / 1'000'000.0;
-    if (c.second.strengthScore > maxScore) {
-      maxScore = c.second.strengthScore;
+        c.ID);
+    c.strengthScore = totalIndustry + totalPop / 1'000'000.0;
+    if (c.strengthScore > maxScore) {
+      maxScore = c.strengthScore;
     }
     // global
     totalWorldIndustry += (int)totalIndustry;
@@ -489,6 +531,7 @@ void Generator::evaluateCountries() {
 }
 
 void Generator::generateCountryUnits() {
+  Tracing::ScopedTimer timer("generateCountryUnits");
   Utils::Logging::logLine("HOI4: Generating Country Unit Files");
   // read in different compositions
   auto unitTemplateFile =
@@ -502,37 +545,37 @@ void Generator::generateCountryUnits() {
     // bully factor? Getting bullied? Infantry+artillery in defensive doctrine
     // bully? Mechanized+armored
     // major nation? more mechanized share
-    auto majorFactor = c.second.relativeScore;
-    auto bullyFactor = 0.05 * c.second.bully / 5.0;
-    if (c.second.rank == "major") {
+    auto majorFactor = c.relativeScore;
+    auto bullyFactor = 0.05 * c.bully / 5.0;
+    if (c.rank == "major") {
       bullyFactor += 0.5;
-    } else if (c.second.rank == "regional") {
+    } else if (c.rank == "regional") {
     }
     // army focus:
     // simply give templates if we qualify for them
     if (majorFactor > 0.5 && bullyFactor > 0.25) {
       // choose one of the mechanised doctrines
       if (RandNum::getRandom(2))
-        c.second.doctrines.push_back(Hoi4Country::doctrineType::blitz);
+        c.doctrines.push_back(Hoi4Country::doctrineType::blitz);
       else
-        c.second.doctrines.push_back(Hoi4Country::doctrineType::armored);
+        c.doctrines.push_back(Hoi4Country::doctrineType::armored);
     }
     if (bullyFactor < 0.25) {
       // will likely get bullied, add defensive doctrines
-      c.second.doctrines.push_back(Hoi4Country::doctrineType::defensive);
+      c.doctrines.push_back(Hoi4Country::doctrineType::defensive);
     }
     // give all stronger powers infantry with support divisions
     if (majorFactor >= 0.2) {
       // any relatively large power has support divisions
-      c.second.doctrines.push_back(Hoi4Country::doctrineType::infantry);
-      c.second.doctrines.push_back(Hoi4Country::doctrineType::artillery);
+      c.doctrines.push_back(Hoi4Country::doctrineType::infantry);
+      c.doctrines.push_back(Hoi4Country::doctrineType::artillery);
       // any relatively large power has support divisions
-      c.second.doctrines.push_back(Hoi4Country::doctrineType::support);
+      c.doctrines.push_back(Hoi4Country::doctrineType::support);
     }
     // give all weaker powers infantry without support
     if (majorFactor < 0.2) {
-      c.second.doctrines.push_back(Hoi4Country::doctrineType::milita);
-      c.second.doctrines.push_back(Hoi4Country::doctrineType::mass);
+      c.doctrines.push_back(Hoi4Country::doctrineType::milita);
+      c.doctrines.push_back(Hoi4Country::doctrineType::mass);
     }
 
     // now evaluate each template and add it if all requirements are fulfilled
@@ -540,19 +583,19 @@ void Generator::generateCountryUnits() {
       auto requirements =
           ParserUtils::getBracketBlockContent(unitTemplates[i], "requirements");
       auto requirementTokens = ParserUtils::getTokens(requirements, ';');
-      if (unitFulfillsRequirements(requirementTokens, c.second)) {
+      if (unitFulfillsRequirements(requirementTokens, c)) {
         // get the ID and save it for used divison templates
-        c.second.units.push_back(i);
+        c.units.push_back(i);
       }
     }
     // now compose the army from the templates
     std::map<int, int> unitCount;
-    c.second.unitCount.resize(100);
-    auto totalUnits = c.second.strengthScore / 5;
+    c.unitCount.resize(100);
+    auto totalUnits = c.strengthScore / 5;
     while (totalUnits-- > 0) {
       // now randomly add units
-      auto unit = Utils::selectRandom(c.second.units);
-      c.second.unitCount[unit]++;
+      auto unit = Utils::selectRandom(c.units);
+      c.unitCount[unit]++;
     }
   }
 }
@@ -686,7 +729,7 @@ void Generator::buildFocusTree(Hoi4Country &source) {
 
 bool Generator::stepFulfillsRequirements(
     const std::string stepRequirements,
-    const std::vector<std::set<Hoi4Country>> &stepTargets) {
+    const std::vector<std::set<CountryId>> &stepTargets) {
 
   const auto predecessors =
       ParserUtils::getBracketBlockContent(stepRequirements, "predecessor");
@@ -712,7 +755,8 @@ bool Generator::stepFulfillsRequirements(
 bool Generator::targetFulfillsRequirements(
     const std::string &targetRequirements, const Hoi4Country &source,
     const Hoi4Country &target, const std::vector<Scenario::Region> &gameRegions,
-    const std::vector<std::set<std::string>> &levelTargets, const int level) {
+    const std::vector<boost::dynamic_bitset<>> &levelTargets,
+    const int level) {
   // now check if the country fulfills the target requirements
   // need to check rank, first get the desired value
   auto value = ParserUtils::getBracketBlockContent(targetRequirements, "rank");
@@ -738,7 +782,7 @@ bool Generator::targetFulfillsRequirements(
   value = ParserUtils::getBracketBlockContent(targetRequirements, "location");
   if (value != "" && value != "any") {
     if (value == "neighbour") {
-      if (source.neighbours.find(target.tag) == source.neighbours.end())
+      if (!source.neighbours.test(target.ID))
         return false;
     }
     if (value == "near") {
@@ -762,19 +806,18 @@ bool Generator::targetFulfillsRequirements(
   if (value != "" && value != "any") {
     if (value == "notlevel") {
       // don't consider this country if already used on same level
-      if (levelTargets[level].find(target.tag) != levelTargets[level].end())
+      if (levelTargets[level].test(target.ID))
         return false;
     }
     if (value == "level") {
       // don't consider this country if NOT used on same level
-      if (levelTargets[level].size() &&
-          levelTargets[level].find(target.tag) == levelTargets[level].end())
+      if (levelTargets[level].any() && !levelTargets[level].test(target.ID))
         return false;
     }
     if (value == "notchain") {
       for (int i = 0; i < levelTargets.size(); i++) {
         // don't consider this country if already used in same chain
-        if (levelTargets[i].find(target.tag) != levelTargets[i].end())
+        if (levelTargets[i].test(target.ID))
           return false;
       }
     }
@@ -782,7 +825,7 @@ bool Generator::targetFulfillsRequirements(
       bool foundUse = false;
       for (int i = 0; i < levelTargets.size(); i++) {
         // don't consider this country if NOT used in same chain
-        if (levelTargets[i].find(target.tag) == levelTargets[i].end())
+        if (!levelTargets[i].test(target.ID))
           foundUse = true;
       }
       if (!foundUse)
@@ -792,31 +835,38 @@ bool Generator::targetFulfillsRequirements(
   return true;
 }
 
-void Generator::evaluateCountryGoals() {
-  Utils::Logging::logLine("HOI4: Generating Country Goals");
-  std::vector<int> defDate{1, 1, 1936};
-  std::vector<std::vector<std::vector<std::string>>> chains;
-
-  chains.push_back(ParserUtils::getLinesByID(
+void Generator::readFocusChains() {
+  if (focusChains.size())
+    return;
+  focusChains.push_back(ParserUtils::getLinesByID(
       "resources\\hoi4\\ai\\national_focus\\chains\\major_chains.txt"));
-  chains.push_back(ParserUtils::getLinesByID(
+  focusChains.push_back(ParserUtils::getLinesByID(
       "resources\\hoi4\\ai\\national_focus\\chains\\regional_chains.txt"));
-  chains.push_back(ParserUtils::getLinesByID(
+  focusChains.push_back(ParserUtils::getLinesByID(
       "resources\\hoi4\\ai\\national_focus\\chains\\army_chains.txt"));
+}
+
+void Generator::evaluateCountryGoals() {
+  Tracing::ScopedTimer timer("evaluateCountryGoals");
+  Utils::Logging::logLine("HOI4: Generating Country Goals");
+  std::vector<int> defDate{1, 1, 1936};
+  readFocusChains();
+  const auto &chains = focusChains;
   auto typeCounter = 0;
   for (auto &sourceCountry : hoi4Countries) {
-    const auto &source = hoi4Countries[sourceCountry.first];
-    sourceCountry.second.bully = 0;
-    // sourceCountry.second.defensive = 0;
+    const auto &source = sourceCountry;
+    sourceCountry.bully = 0;
+    // sourceCountry.defensive = 0;
     for (const auto &chainType : chains) {
       for (const auto &chain : chainType) {
         // evaluate whole chain (chain defined by ID)
         if (!chain.size())
           continue;
         // we need to save options for every chain step
-        std::vector<std::set<Hoi4Country>> stepTargets;
+        std::vector<std::set<CountryId>> stepTargets;
         stepTargets.resize(100);
-        std::vector<std::set<std::string>> levelTargets(chain.size());
+        std::vector<boost::dynamic_bitset<>> levelTargets(
+            chain.size(), boost::dynamic_bitset<>(hoi4Countries.size()));
         int chainID = 0;
         for (const auto &chainFocus : chain) {
           Utils::Logging::logLineLevel(9, chainFocus);
@@ -834,21 +884,19 @@ void Generator::evaluateCountryGoals() {
               // if there are no target requirements, only the country itself is
               // a target
               if (!targetRequirements.size())
-                stepTargets[chainStep].insert(sourceCountry.second);
+                stepTargets[chainStep].insert(sourceCountry.ID);
               else {
                 for (auto &destCountry : hoi4Countries) {
                   // now check every country if it fulfills the target
                   // requirements
-                  if (targetFulfillsRequirements(
-                          targetRequirements,
-                          hoi4Countries[sourceCountry.first],
-                          destCountry.second, gameRegions, levelTargets,
-                          level)) {
-                    stepTargets[chainStep].insert(destCountry.second);
+                  if (targetFulfillsRequirements(targetRequirements, source,
+                                                 destCountry, gameRegions,
+                                                 levelTargets, level)) {
+                    stepTargets[chainStep].insert(destCountry.ID);
                     // save that we targeted this country on this level already.
                     // Next steps on same level should not consider this tag
                     // anymore
-                    levelTargets[level].insert(destCountry.first);
+                    levelTargets[level].set(destCountry.ID);
                   }
                 }
               }
@@ -868,25 +916,24 @@ void Generator::evaluateCountryGoals() {
             if (!targets.size())
               continue;
             // select random target
-            const auto &target = Utils::selectRandom(targets);
+            const auto &target = hoi4Countries[Utils::selectRandom(targets)];
             auto focus{buildFocus(ParserUtils::getTokens(chain[stepIndex], ';'),
-                                  hoi4Countries.at(sourceCountry.first),
-                                  target)};
+                                  source, target)};
             focus.stepID = stepIndex;
             focus.chainID = chainID;
             Utils::Logging::logLineLevel(1, focus);
             if (focus.fType == NationalFocus::FocusType::attack) {
               // country aims to bully
-              sourceCountry.second.bully++;
+              sourceCountry.bully++;
             }
             chainFoci.push_back(focus);
           }
-          sourceCountry.second.foci.push_back(chainFoci);
+          sourceCountry.foci.push_back(chainFoci);
         }
       }
     }
     // now build a tree out of the focus chains
-    buildFocusTree(sourceCountry.second);
+    buildFocusTree(sourceCountry);
   }
 }
 
@@ -904,8 +951,8 @@ void Generator::printStatistics() {
   for (auto &scores : strengthScores) {
     for (auto &entry : scores.second) {
       Utils::Logging::logLine("Strength: ", scores.first, " ",
-                              hoi4Countries.at(entry).fullName, " ",
-                              hoi4Countries.at(entry).rulingParty, "");
+                              hoi4Countries[entry].fullName, " ",
+                              hoi4Countries[entry].rulingParty, "");
     }
   }
 }
@@ -3,17 +3,18 @@ using namespace Fwg;
 namespace Scenario::Hoi4 {
 Hoi4Module::Hoi4Module(const boost::property_tree::ptree &gamesConf,
                        const std::string &configSubFolder,
-                       const std::string &username, const bool mapCountries) {
-
-  FastWorldGenerator fwg(configSubFolder);
+                       const std::string &username, const bool mapCountries)
+    : configSubFolder(configSubFolder) {
   // read hoi configs and potentially overwrite settings for fwg
   readHoiConfig(configSubFolder, username, gamesConf);
   if (!mapCountries) {
-    // now run the world generation
-    fwg.generateWorld();
+    // read the static resources once, they are reused for every scenario we
+    // generate
+    nameData = NameGeneration::prepare("resources\\names", gamePath);
+    NationalFocus::buildMaps();
+    Generator::readFocusChains();
+    formatConverter = {gamePath, "Hoi4"};
   }
-  hoi4Gen = {fwg};
-  hoi4Gen.nData = NameGeneration::prepare("resources\\names", gamePath);
 }
 
 Hoi4Module::~Hoi4Module() {}
@@ -89,7 +90,7 @@ void Hoi4Module::readHoiConfig(const std::string &configSubFolder,
     Utils::Logging::logLine(
         "Otherwise try running it through a json validator, e.g. "
         "\"https://jsonlint.com/\" or search for \"json validator\"");
-    system("pause");
+    Scenario::pause();
   }
   // default values taken from base game
   hoi4Gen.resources = {
@@ -107,26 +108,55 @@ void Hoi4Module::readHoiConfig(const std::string &configSubFolder,
 
   //  passed to generic ScenarioGenerator
   numCountries = hoi4Conf.get<int>("scenario.numCountries");
-  config.loadMapsPath = hoi4Conf.get<std::string>("fastworldgen.loadMapsPath");
-  config.heightmapIn = config.loadMapsPath +
-                       hoi4Conf.get<std::string>("fastworldgen.heightMapName");
+  regionsPerCountry = hoi4Conf.get<int>("scenario.regionsPerCountry", 6);
+  loadMapsPath = hoi4Conf.get<std::string>("fastworldgen.loadMapsPath");
+  heightmapIn =
+      loadMapsPath + hoi4Conf.get<std::string>("fastworldgen.heightMapName");
+  applyFwgOverrides();
   cut = config.cut;
+  numThreads = rpdConf.get<unsigned int>("randomScenario.numThreads");
+  saveSnapshots = rpdConf.get<bool>("Snapshot.save");
+  snapshotPath = rpdConf.get<std::string>("Snapshot.path");
   // check if config settings are fine
   config.sanityCheck();
 }
 
+void Hoi4Module::applyFwgOverrides() {
+  auto &config = Cfg::Values();
+  config.loadMapsPath = loadMapsPath;
+  config.heightmapIn = heightmapIn;
+}
+
+void Hoi4Module::generateWorld() {
+  Tracing::ScopedTimer timer("fwg::generateWorld");
+  // constructing the world generator reads its config again, keep the
+  // settings of this run and apply them on top
+  const auto seed = Cfg::Values().seed;
+  const auto writeMaps = Cfg::Values().writeMaps;
+  // the generator takes over the world instead of copying all of its maps
+  auto fwg = std::make_shared<FastWorldGenerator>(configSubFolder);
+  applyFwgOverrides();
+  applyRunSettings(seed, writeMaps);
+  fwg->generateWorld();
+  hoi4Gen = {fwg};
+  hoi4Gen.numThreads = numThreads;
+  // copy, as the generation of tags modifies the name data
+  hoi4Gen.nData = nameData;
+}
+
 void Hoi4Module::genHoi() {
+  Tracing::ScopedTimer timer("genHoi");
   if (!createPaths())
     return;
   try {
+    generateWorld();
     // start with the generic stuff in the Scenario Generator
     hoi4Gen.mapRegions();
     hoi4Gen.mapContinents();
-    hoi4Gen.generateCountries(numCountries, gamePath);
+    hoi4Gen.generateCountries(numCountries, regionsPerCountry, gamePath);
     hoi4Gen.evaluateNeighbours();
     hoi4Gen.generateWorld();
-    Fwg::Gfx::Bitmap countryMap =
-        hoi4Gen.dumpDebugCountrymap(Cfg::Values().mapsPath + "countries.bmp");
+    hoi4Gen.dumpDebugCountrymap(Cfg::Values().mapsPath + "countries.bmp");
 
     // now generate hoi4 specific stuff
     hoi4Gen.generateCountrySpecifics();
@@ -135,103 +165,244 @@ void Hoi4Module::genHoi() {
     hoi4Gen.generateStrategicRegions();
     hoi4Gen.generateWeather();
     hoi4Gen.evaluateCountries();
-    hoi4Gen.generateLogistics(countryMap);
-    NationalFocus::buildMaps();
+    hoi4Gen.generateLogistics();
     hoi4Gen.evaluateCountryGoals();
     hoi4Gen.generateCountryUnits();
+    if (saveSnapshots) {
+      const auto folder = std::filesystem::path(snapshotPath).parent_path();
+      if (!folder.empty())
+        std::filesystem::create_directories(folder);
+      saveSnapshot(snapshotPath, hoi4Gen);
+    }
   } catch (std::exception e) {
     std::string error = "Error while generating the Hoi4 Module.\n";
     error += "Error is: \n";
     error += e.what();
     throw(std::exception(error.c_str()));
   }
-  // now start writing game files
+  writeFiles();
+  // now if everything worked, print info about world and pause for user to
+  // see
+  hoi4Gen.printStatistics();
+}
+
+void Hoi4Module::genHoiFromSnapshot() {
+  Tracing::ScopedTimer timer("genHoiFromSnapshot");
+  // the snapshot is kept outside of the mod folder, which createPaths clears
+  if (!createPaths())
+    return;
   try {
+    hoi4Gen = Generator();
+    loadSnapshot(snapshotPath, hoi4Gen, provinceStore);
+    hoi4Gen.nData = nameData;
+  } catch (std::exception e) {
+    std::string error = "Error while loading the Hoi4 snapshot.\n";
+    error += "Error is: \n";
+    error += e.what();
+    throw(std::exception(error.c_str()));
+  }
+  writeFiles();
+}
 
+void Hoi4Module::writeFiles() {
+  try {
     // generate map files. Format must be converted and colours mapped to hoi4
     // compatible colours
-    Gfx::FormatConverter formatConverter(gamePath, "Hoi4");
-    formatConverter.dump8BitTerrain(hoi4Gen.fwg.climateMap,
-                                    gameModPath + "\\map\\terrain.bmp",
-                                    "terrain", cut);
-    formatConverter.dump8BitCities(hoi4Gen.fwg.climateMap,
-                                   gameModPath + "\\map\\cities.bmp", "cities",
-                                   cut);
-    formatConverter.dump8BitRivers(
-        hoi4Gen.fwg.riverMap, gameModPath + "\\map\\rivers.bmp", "rivers", cut);
-    formatConverter.dump8BitTrees(hoi4Gen.fwg.climateMap, hoi4Gen.fwg.treeMap,
-                                  gameModPath + "\\map\\trees.bmp", "trees",
-                                  false);
-    formatConverter.dump8BitHeightmap(hoi4Gen.fwg.heightMap,
-                                      gameModPath + "\\map\\heightmap.bmp",
-                                      "heightmap");
-    formatConverter.dumpTerrainColourmap(
-        hoi4Gen.fwg.summerMap, hoi4Gen.fwg.cityMap, gameModPath,
-        "\\map\\terrain\\colormap_rgb_cityemissivemask_a.dds",
-        DXGI_FORMAT_B8G8R8A8_UNORM, cut);
-    formatConverter.dumpDDSFiles(
-        hoi4Gen.fwg.riverMap, hoi4Gen.fwg.heightMap,
-        gameModPath + "\\map\\terrain\\colormap_water_", cut, 8);
-    formatConverter.dumpWorldNormal(
-        hoi4Gen.fwg.sobelMap, gameModPath + "\\map\\world_normal.bmp", cut);
+    // the writers only read the generated state, so they may run concurrently.
+    // Writers drawing random numbers are chained in their original order to
+    // keep the output identical to a sequential run
+    TaskGraph writers(numThreads);
+    writers.add("terrain", [&] {
+      formatConverter.dump8BitTerrain(hoi4Gen.fwg->climateMap,
+                                      gameModPath + "\\map\\terrain.bmp",
+                                      "terrain", cut);
+    });
+    writers.add("cities", [&] {
+      formatConverter.dump8BitCities(hoi4Gen.fwg->climateMap,
+                                     gameModPath + "\\map\\cities.bmp",
+                                     "cities", cut);
+    });
+    writers.add("rivers", [&] {
+      formatConverter.dump8BitRivers(hoi4Gen.fwg->riverMap,
+                                     gameModPath + "\\map\\rivers.bmp",
+                                     "rivers", cut);
+    });
+    writers.add("trees", [&] {
+      formatConverter.dump8BitTrees(hoi4Gen.fwg->climateMap,
+                                    hoi4Gen.fwg->treeMap,
+                                    gameModPath + "\\map\\trees.bmp", "trees",
+                                    false);
+    });
+    writers.add("heightmap", [&] {
+      formatConverter.dump8BitHeightmap(hoi4Gen.fwg->heightMap,
+                                        gameModPath + "\\map\\heightmap.bmp",
+                                        "heightmap");
+    });
+    writers.add("colourmap", [&] {
+      formatConverter.dumpTerrainColourmap(
+          hoi4Gen.fwg->summerMap, hoi4Gen.fwg->cityMap, gameModPath,
+          "\\map\\terrain\\colormap_rgb_cityemissivemask_a.dds",
+          DXGI_FORMAT_B8G8R8A8_UNORM, cut);
+    });
+    writers.add("waterColourmap", [&] {
+      formatConverter.dumpDDSFiles(
+          hoi4Gen.fwg->riverMap, hoi4Gen.fwg->heightMap,
+          gameModPath + "\\map\\terrain\\colormap_water_", cut, 8);
+    });
+    writers.add("worldNormal", [&] {
+      formatConverter.dumpWorldNormal(
+          hoi4Gen.fwg->sobelMap, gameModPath + "\\map\\world_normal.bmp", cut);
+    });
 
     using namespace Parsing::Writing;
-    compatibilityHistory(gameModPath + "\\history\\countries\\", gamePath,
-                         hoi4Gen.fwg.areas.regions);
-    historyCountries(gameModPath + "\\history\\countries\\",
-                     hoi4Gen.hoi4Countries);
-    historyUnits(gameModPath + "\\history\\units\\", hoi4Gen.hoi4Countries);
-    commonCountryTags(gameModPath + "\\common\\country_tags\\02_countries.txt",
+    const auto compatibility = writers.add("compatibilityHistory", [&] {
+      compatibilityHistory(gameModPath + "\\history\\countries\\", gamePath,
+                           hoi4Gen.fwg->areas.regions);
+    });
+    // writes into the same folder, so only start after the compatibility files
+    auto random = writers.add(
+        "historyCountries",
+        [&] {
+          historyCountries(gameModPath + "\\history\\countries\\",
+                           hoi4Gen.hoi4Countries);
+        },
+        {compatibility});
+    writers.add("historyUnits", [&] {
+      historyUnits(gameModPath + "\\history\\units\\", hoi4Gen.hoi4Countries,
+                   hoi4Gen.hoi4Regions);
+    });
+    writers.add("commonCountryTags", [&] {
+      commonCountryTags(gameModPath +
+                            "\\common\\country_tags\\02_countries.txt",
+                        hoi4Gen.hoi4Countries);
+    });
+    writers.add("commonCountries", [&] {
+      commonCountries(gameModPath + "\\common\\countries\\",
+                      gamePath + "\\common\\countries\\colors.txt",
                       hoi4Gen.hoi4Countries);
-    commonCountries(gameModPath + "\\common\\countries\\",
-                    gamePath + "\\common\\countries\\colors.txt",
-                    hoi4Gen.hoi4Countries);
-    adj(gameModPath + "\\map\\adjacencies.csv");
-    airports(gameModPath + "\\map\\airports.txt", hoi4Gen.fwg.areas.regions);
-    buildings(gameModPath + "\\map\\buildings.txt", hoi4Gen.fwg.areas.regions,
-              hoi4Gen.fwg.heightMap);
-    continents(gameModPath + "\\map\\continents.txt",
-               hoi4Gen.fwg.areas.continents);
-    definition(gameModPath + "\\map\\definition.csv", hoi4Gen.gameProvinces);
-    unitStacks(gameModPath + "\\map\\unitstacks.txt",
-               hoi4Gen.fwg.areas.provinces, hoi4Gen.fwg.heightMap);
-    rocketSites(gameModPath + "\\map\\rocketsites.txt",
-                hoi4Gen.fwg.areas.regions);
-    strategicRegions(gameModPath + "\\map\\strategicregions",
-                     hoi4Gen.fwg.areas.regions, hoi4Gen.strategicRegions);
-    states(gameModPath + "\\history\\states", hoi4Gen.hoi4Countries);
-    flags(gameModPath + "\\gfx\\flags\\", hoi4Gen.hoi4Countries);
-    weatherPositions(gameModPath + "\\map\\weatherpositions.txt",
-                     hoi4Gen.fwg.areas.regions, hoi4Gen.strategicRegions);
-    adjacencyRules(gameModPath + "\\map\\adjacency_rules.txt");
-    supply(gameModPath + "\\map\\", hoi4Gen.supplyNodeConnections);
-    stateNames(gameModPath + "\\localisation\\english\\",
-               hoi4Gen.hoi4Countries);
-    countryNames(gameModPath + "\\localisation\\english\\",
-                 hoi4Gen.hoi4Countries, hoi4Gen.nData);
-    strategicRegionNames(gameModPath + "\\localisation\\english\\",
-                         hoi4Gen.strategicRegions);
-    foci(gameModPath + "\\common\\national_focus\\", hoi4Gen.hoi4Countries,
-         hoi4Gen.nData);
-    commonBookmarks(gameModPath + "\\common\\bookmarks\\",
-                    hoi4Gen.hoi4Countries, hoi4Gen.strengthScores);
-    tutorials(gameModPath + "\\tutorial\\tutorial.txt");
-
-    Parsing::copyDescriptorFile("resources\\hoi4\\descriptor.mod", gameModPath,
-                                gameModsDirectory, modName);
-
+    });
+    writers.add("adj", [&] { adj(gameModPath + "\\map\\adjacencies.csv"); });
+    writers.add("airports", [&] {
+      airports(gameModPath + "\\map\\airports.txt", hoi4Gen.fwg->areas.regions);
+    });
+    random = writers.add(
+        "buildings",
+        [&] {
+          buildings(gameModPath + "\\map\\buildings.txt",
+                    hoi4Gen.fwg->areas.regions, hoi4Gen.fwg->heightMap);
+        },
+        {random});
+    writers.add("continents", [&] {
+      continents(gameModPath + "\\map\\continents.txt",
+                 hoi4Gen.fwg->areas.continents);
+    });
+    writers.add("definition", [&] {
+      definition(gameModPath + "\\map\\definition.csv", hoi4Gen.provinceTable);
+    });
+    random = writers.add(
+        "unitStacks",
+        [&] {
+          unitStacks(gameModPath + "\\map\\unitstacks.txt",
+                     hoi4Gen.fwg->areas.provinces, hoi4Gen.fwg->heightMap);
+        },
+        {random});
+    writers.add("rocketSites", [&] {
+      rocketSites(gameModPath + "\\map\\rocketsites.txt",
+                  hoi4Gen.fwg->areas.regions);
+    });
+    writers.add("strategicRegions", [&] {
+      strategicRegions(gameModPath + "\\map\\strategicregions",
+                       hoi4Gen.fwg->areas.regions, hoi4Gen.strategicRegions);
+    });
+    writers.add("states", [&] {
+      states(gameModPath + "\\history\\states", hoi4Gen.hoi4Countries,
+             hoi4Gen.hoi4Regions, hoi4Gen.provinceTable);
+    });
+    // the flag encodes are split into chunks on the writer threads, instead
+    // of running a pool of their own inside one writer
+    const auto countryCount = (int)hoi4Gen.hoi4Countries.size();
+    const auto flagChunks = TaskGraph::chunkCount(countryCount, numThreads);
+    for (auto chunk = 0; chunk < flagChunks; chunk++)
+      writers.add("flags", [&, chunk] {
+        flags(gameModPath + "\\gfx\\flags\\", hoi4Gen.flagAtlas,
+              hoi4Gen.hoi4Countries, chunk * countryCount / flagChunks,
+              (chunk + 1) * countryCount / flagChunks);
+      });
+    random = writers.add(
+        "weatherPositions",
+        [&] {
+          weatherPositions(gameModPath + "\\map\\weatherpositions.txt",
+                           hoi4Gen.fwg->areas.regions, hoi4Gen.strategicRegions);
+        },
+        {random});
+    writers.add("adjacencyRules", [&] {
+      adjacencyRules(gameModPath + "\\map\\adjacency_rules.txt");
+    });
+    writers.add("supply", [&] {
+      supply(gameModPath + "\\map\\", hoi4Gen.supplyNodeConnections);
+    });
+    writers.add("stateNames", [&] {
+      stateNames(gameModPath + "\\localisation\\english\\",
+                 hoi4Gen.hoi4Countries, hoi4Gen.hoi4Regions);
+    });
+    random = writers.add(
+        "countryNames",
+        [&] {
+          countryNames(gameModPath + "\\localisation\\english\\",
+                       hoi4Gen.hoi4Countries, hoi4Gen.nData);
+        },
+        {random});
+    writers.add("strategicRegionNames", [&] {
+      strategicRegionNames(gameModPath + "\\localisation\\english\\",
+                           hoi4Gen.strategicRegions);
+    });
+    random = writers.add(
+        "foci",
+        [&] {
+          foci(gameModPath + "\\common\\national_focus\\",
+               hoi4Gen.hoi4Countries, hoi4Gen.nData);
+        },
+        {random});
+    writers.add("commonBookmarks", [&] {
+      commonBookmarks(gameModPath + "\\common\\bookmarks\\",
+                      hoi4Gen.hoi4Countries, hoi4Gen.strengthScores);
+    });
+    writers.add("tutorials", [&] {
+      tutorials(gameModPath + "\\tutorial\\tutorial.txt");
+    });
+    writers.add("descriptor", [&] {
+      Parsing::copyDescriptorFile("resources\\hoi4\\descriptor.mod",
+                                  gameModPath, gameModsDirectory, modName);
+    });
     // just copy over provinces.bmp, already in a compatible format
-    Fwg::Gfx::Bmp::save(hoi4Gen.fwg.provinceMap,
-                        (gameModPath + ("\\map\\provinces.bmp")).c_str());
+    writers.add("provinces", [&] {
+      Fwg::Gfx::Bmp::save(hoi4Gen.fwg->provinceMap,
+                          (gameModPath + ("\\map\\provinces.bmp")).c_str());
+      Tracing::addFileBytes(gameModPath + "\\map\\provinces.bmp");
+    });
+    Tracing::ScopedTimer writeTimer("writeFiles");
+    writers.run();
+    // the debug maps of the generation were written meanwhile
+    DebugMaps::flush();
   } catch (std::exception e) {
     std::string error = "Error while dumping and writing files.\n";
     error += "Error is: \n";
     error += e.what();
     throw(std::exception(error.c_str()));
   }
-  // now if everything worked, print info about world and pause for user to
-  // see
-  hoi4Gen.printStatistics();
+}
+
+void Hoi4Module::genHoiBatch(const int firstSeed, const int lastSeed) {
+  for (auto seed = firstSeed; seed <= lastSeed; seed++) {
+    Utils::Logging::logLine("HOI4: Generating scenario for seed ", seed);
+    boost::property_tree::ptree job;
+    job.put("seed", seed);
+    runJob(job, [this] { genHoi(); });
+  }
+}
+
+void Hoi4Module::genHoiJob(const boost::property_tree::ptree &job) {
+  runJob(job, [this] { genHoi(); });
 }
 void Hoi4Module::mapCountries(bool multiCore) {
   // prepare folder structure
@@ -1,12 +1,12 @@
 #include "hoi4/Hoi4Parsing.h"
+#include "generic/Tracing.h"
 #include "hoi4/NationalFocus.h"
 using namespace Fwg;
-namespace Logging = Fwg::Utils::Logging;
 namespace pU = Scenario::ParserUtils;
 namespace Scenario::Hoi4::Parsing {
 namespace Writing {
 void adj(const std::string &path) {
-  Logging::logLine("HOI4 Parser: Map: Writing Adjacencies");
+  Tracing::logLine("HOI4 Parser: Map: Writing Adjacencies");
   // From;To;Type;Through;start_x;start_y;stop_x;stop_y;adjacency_rule_name;Comment
   // empty file for now
   std::string content;
@@ -17,7 +17,7 @@ void adj(const std::string &path) {
 
 void airports(const std::string &path,
               const std::vector<Fwg::Region> &regions) {
-  Logging::logLine("HOI4 Parser: Map: Building Airfields");
+  Tracing::logLine("HOI4 Parser: Map: Building Airfields");
   std::string content;
   for (const auto &region : regions) {
     if (region.sea)
@@ -38,7 +38,7 @@ void airports(const std::string &path,
 // places building positions
 void buildings(const std::string &path, const std::vector<Fwg::Region> &regions,
                const Fwg::Gfx::Bitmap &heightMap) {
-  Logging::logLine("HOI4 Parser: Map: Constructing Factories");
+  Tracing::logLine("HOI4 Parser: Map: Constructing Factories");
   std::vector<std::string> buildingTypes{
       "arms_factory",    "industrial_complex", "air_base",
       "bunker",          "coastal_bunker",     "dockyard",
@@ -122,7 +122,7 @@ void buildings(const std::string &path, const std::vector<Fwg::Region> &regions,
 
 void continents(const std::string &path,
                 const std::vector<Continent> &continents) {
-  Logging::logLine("HOI4 Parser: Map: Writing Continents");
+  Tracing::logLine("HOI4 Parser: Map: Writing Continents");
   std::string content{"continents = {\n"};
 
   for (const auto &continent : continents) {
@@ -134,9 +134,8 @@ void continents(const std::string &path,
   pU::writeFile(path, content);
 }
 
-void definition(const std::string &path,
-                const std::vector<GameProvince> &provinces) {
-  Logging::logLine("HOI4 Parser: Map: Defining Provinces");
+void definition(const std::string &path, const ProvinceTable &provinceTable) {
+  Tracing::logLine("HOI4 Parser: Map: Defining Provinces");
   // province id; r value; g value; b value; province type (land/sea/lake);
   // coastal (true/false); terrain (plains/hills/urban/etc. Defined for land or
   // sea provinces in common/terrain); continent (int)
@@ -147,35 +146,36 @@ void definition(const std::string &path,
   // properly map terrain types from climate
   // Bitmap typeMap(512, 512, 24);
   std::string content{"0;0;0;0;land;false;unknown;0\n"};
-  for (const auto &prov : provinces) {
-    auto seaType = prov.baseProvince->sea ? "sea" : "land";
-    auto coastal = prov.baseProvince->coastal ? "true" : "false";
-    if (prov.baseProvince->sea) {
-      for (auto prov2 : prov.baseProvince->neighbours) {
-        if (!prov2->sea)
+  for (auto ID = 0; ID < provinceTable.size(); ID++) {
+    const auto baseProvince = provinceTable.baseProvinces[ID];
+    auto seaType = baseProvince->sea ? "sea" : "land";
+    auto coastal = baseProvince->coastal ? "true" : "false";
+    if (baseProvince->sea) {
+      for (const auto neighbourID : provinceTable.neighbours(ID)) {
+        if (!provinceTable.baseProvinces[neighbourID]->sea)
           coastal = "true";
       }
     }
     std::string terraintype;
-    if (prov.baseProvince->sea)
+    if (baseProvince->sea)
       terraintype = "ocean";
     else
-      terraintype = prov.terrainType;
-    if (prov.baseProvince->isLake) {
+      terraintype = provinceTable.terrainType(ID);
+    if (baseProvince->isLake) {
       terraintype = "lakes";
       seaType = "lake";
     }
     std::vector<std::string> arguments{
-        std::to_string(prov.baseProvince->ID + 1),
-        std::to_string(prov.baseProvince->colour.getRed()),
-        std::to_string(prov.baseProvince->colour.getGreen()),
-        std::to_string(prov.baseProvince->colour.getBlue()),
+        std::to_string(baseProvince->ID + 1),
+        std::to_string(baseProvince->colour.getRed()),
+        std::to_string(baseProvince->colour.getGreen()),
+        std::to_string(baseProvince->colour.getBlue()),
         seaType,
         coastal,
         terraintype,
-        std::to_string(prov.baseProvince->sea || prov.baseProvince->isLake
+        std::to_string(baseProvince->sea || baseProvince->isLake
                            ? 0
-                           : prov.baseProvince->continentID +
+                           : baseProvince->continentID +
                                  1) // 0 is for sea, no continent
     };
     content.append(pU::csvFormat(arguments, ';', false));
@@ -185,7 +185,7 @@ void definition(const std::string &path,
 
 void rocketSites(const std::string &path,
                  const std::vector<Fwg::Region> &regions) {
-  Logging::logLine("HOI4 Parser: Map: Launching Rockets");
+  Tracing::logLine("HOI4 Parser: Map: Launching Rockets");
   std::string content;
   // regionId={provId }
   for (const auto &region : regions) {
@@ -207,7 +207,7 @@ void rocketSites(const std::string &path,
 void unitStacks(const std::string &path,
                 const std::vector<Province *> provinces,
                 const Fwg::Gfx::Bitmap &heightMap) {
-  Logging::logLine("HOI4 Parser: Map: Remilitarizing the Rhineland");
+  Tracing::logLine("HOI4 Parser: Map: Remilitarizing the Rhineland");
   // 1;0;3359.00;9.50;1166.00;0.00;0.08
   // provID, neighbour?, xPos, zPos yPos, rotation(3=north,
   // 0=south, 1.5=east,4,5=west), ?? provID, xPos, ~10, yPos, ~0, 0,5 for each
@@ -253,7 +253,7 @@ void unitStacks(const std::string &path,
 void weatherPositions(const std::string &path,
                       const std::vector<Fwg::Region> &regions,
                       const std::vector<strategicRegion> &strategicRegions) {
-  Logging::logLine("HOI4 Parser: Map: Creating Storms");
+  Tracing::logLine("HOI4 Parser: Map: Creating Storms");
   // 1; 2781.24; 9.90; 1571.49; small
   std::string content{""};
   // stateId; pixelX; rotation??; pixelY; rotation??; size
@@ -274,7 +274,7 @@ void weatherPositions(const std::string &path,
 }
 
 void adjacencyRules(const std::string &path) {
-  Logging::logLine("HOI4 Parser: Map: Writing Adjacency Rules");
+  Tracing::logLine("HOI4 Parser: Map: Writing Adjacency Rules");
   std::string content{""};
   // empty for now
   pU::writeFile(path, content);
@@ -285,7 +285,7 @@ void strategicRegions(const std::string &path,
                       const std::vector<strategicRegion> &strategicRegions) {
   constexpr std::array<int, 12> daysInMonth{30, 27, 30, 29, 30, 29,
                                             30, 30, 29, 30, 29, 30};
-  Logging::logLine("HOI4 Parser: Map: Drawing Strategic Regions");
+  Tracing::logLine("HOI4 Parser: Map: Drawing Strategic Regions");
   auto templateContent =
       pU::readFile("resources\\hoi4\\map\\strategic_region.txt");
   const auto templateWeather = pU::getBracketBlock(templateContent, "period");
@@ -376,14 +376,19 @@ void supply(const std::string &path,
   ParserUtils::writeFile(path + "railways.txt", railways);
 }
 
-void states(const std::string &path, const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: History: Drawing State Borders");
+void states(const std::string &path, const hoiMap &countries,
+            const std::vector<Region> &hoi4Regions,
+            const ProvinceTable &provinceTable) {
+  Tracing::logLine("HOI4 Parser: History: Drawing State Borders");
   auto templateContent = pU::readFile("resources\\hoi4\\history\\state.txt");
   std::vector<std::string> stateCategories{
       "wasteland",  "small_island", "pastoral",   "rural",      "town",
       "large_town", "city",         "large_city", "metropolis", "megalopolis"};
+  const auto &navalBaseLevels =
+      provinceTable.doubleAttributes[ProvinceTable::navalBases];
   for (const auto &country : countries) {
-    for (const auto &region : country.second.hoi4Regions) {
+    for (const auto &regionID : country.ownedRegions) {
+      const auto &region = hoi4Regions[regionID];
       if (region.sea)
         continue;
       std::string provString{""};
@@ -395,7 +400,7 @@ void states(const std::string &path, const hoiMap &countries) {
       pU::replaceOccurences(content, "templateID",
                             std::to_string(region.ID + 1));
       pU::replaceOccurences(content, "template_provinces", provString);
-      pU::replaceOccurences(content, "templateOwner", country.first);
+      pU::replaceOccurences(content, "templateOwner", country.tag);
       pU::replaceOccurences(
           content, "templateInfrastructure",
           std::to_string(1 + (int)(region.development * 4.0)));
@@ -410,11 +415,11 @@ void states(const std::string &path, const hoiMap &countries) {
       pU::replaceOccurences(content, "templateStateCategory",
                             stateCategories[(int)region.stateCategory]);
       std::string navalBaseContent = "";
-      for (const auto &gameProv : region.gameProvinces) {
-        if (gameProv.attributeDoubles.at("naval_bases") > 0) {
+      for (const auto &prov : region.provinces) {
+        if (navalBaseLevels[prov->ID] > 0) {
           navalBaseContent +=
-              std::to_string(gameProv.ID + 1) + " = {\n\t\t\t\tnaval_base = " +
-              std::to_string((int)gameProv.attributeDoubles.at("naval_bases")) +
+              std::to_string(prov->ID + 1) + " = {\n\t\t\t\tnaval_base = " +
+              std::to_string((int)navalBaseLevels[prov->ID]) +
               "\n\t\t\t}\n\t\t\t";
         }
       }
@@ -437,52 +442,57 @@ void states(const std::string &path, const hoiMap &countries) {
     }
   }
 }
-void flags(const std::string &path, const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: Gfx: Printing Flags");
+void flags(const std::string &path, const Gfx::FlagAtlas &flagAtlas,
+           const hoiMap &countries, const int first, const int end) {
+  Tracing::logLine("HOI4 Parser: Gfx: Printing Flags");
   using namespace Gfx::Textures;
-  for (const auto &country : countries) {
-    writeTGA(country.second.flag.width, country.second.flag.height,
-             country.second.flag.getFlag(), path + country.first + ".tga");
-    writeTGA(country.second.flag.width / 2, country.second.flag.height / 2,
-             country.second.flag.resize(country.second.flag.width / 2,
-                                        country.second.flag.height / 2),
-             path + "\\medium\\" + country.first + ".tga");
-    writeTGA(10, 7, country.second.flag.resize(10, 7),
-             path + "\\small\\" + country.first + ".tga");
+  const auto width = flagAtlas.width;
+  const auto height = flagAtlas.height;
+  for (auto i = first; i < end; i++) {
+    const auto &country = countries[i];
+    auto largeFlag = flagAtlas.resize(country.flagIndex, width, height);
+    writeTGA(width, height, largeFlag, path + country.tag + ".tga");
+    auto mediumFlag =
+        flagAtlas.resize(country.flagIndex, width / 2, height / 2);
+    writeTGA(width / 2, height / 2, mediumFlag,
+             path + "\\medium\\" + country.tag + ".tga");
+    auto smallFlag = flagAtlas.resize(country.flagIndex, 10, 7);
+    writeTGA(10, 7, smallFlag, path + "\\small\\" + country.tag + ".tga");
   }
 }
 
 void historyCountries(const std::string &path, const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: History: Writing Country History");
+  Tracing::logLine("HOI4 Parser: History: Writing Country History");
   const auto content =
       pU::readFile("resources\\hoi4\\history\\country_template.txt");
   for (const auto &country : countries) {
-    auto tempPath = path + country.first + " - " + country.second.name + ".txt";
+    auto tempPath = path + country.tag + " - " + country.name + ".txt";
     auto countryText{content};
     auto capitalID = 1;
-    if (country.second.hoi4Regions.size())
-      capitalID = (Utils::selectRandom(country.second.hoi4Regions)).ID + 1;
+    if (country.ownedRegions.size())
+      capitalID = Utils::selectRandom(country.ownedRegions) + 1;
     pU::replaceOccurences(countryText, "templateCapital",
                           std::to_string(capitalID));
-    pU::replaceOccurences(countryText, "templateTag", country.first);
+    pU::replaceOccurences(countryText, "templateTag", country.tag);
     pU::replaceOccurences(countryText, "templateParty",
-                          country.second.rulingParty);
-    std::string electAllowed = country.second.allowElections ? "yes" : "no";
+                          country.rulingParty);
+    std::string electAllowed = country.allowElections ? "yes" : "no";
     pU::replaceOccurences(countryText, "templateAllowElections", electAllowed);
     pU::replaceOccurences(countryText, "templateFasPop",
-                          std::to_string(country.second.parties[0]));
+                          std::to_string(country.parties[0]));
     pU::replaceOccurences(countryText, "templateDemPop",
-                          std::to_string(country.second.parties[1]));
+                          std::to_string(country.parties[1]));
     pU::replaceOccurences(countryText, "templateComPop",
-                          std::to_string(country.second.parties[2]));
+                          std::to_string(country.parties[2]));
     pU::replaceOccurences(countryText, "templateNeuPop",
-                          std::to_string(country.second.parties[3]));
+                          std::to_string(country.parties[3]));
     pU::writeFile(tempPath, countryText);
   }
 }
 
-void historyUnits(const std::string &path, const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: History: Deploying the Troops");
+void historyUnits(const std::string &path, const hoiMap &countries,
+                  const std::vector<Region> &hoi4Regions) {
+  Tracing::logLine("HOI4 Parser: History: Deploying the Troops");
   const auto defaultTemplate =
       pU::readFile("resources\\hoi4\\history\\default_unit_template.txt");
   const auto unitBlock =
@@ -506,7 +516,7 @@ void historyUnits(const std::string &path, const hoiMap &countries) {
     std::string unitFile = defaultTemplate;
     std::string divisionTemplates = "";
     // now insert all the unit templates for this country
-    for (const auto ID : country.second.units) {
+    for (const auto ID : country.units) {
       divisionTemplates.append(unitTemplates[ID]);
       // we need to buffer the names of the templates for use in later unit
       // generationm
@@ -525,9 +535,9 @@ void historyUnits(const std::string &path, const hoiMap &countries) {
     // templates under the "divisions" key in the unitFile
     std::string totalUnits = "";
     // for every entry in unitCount vector
-    for (int i = 0; i < country.second.unitCount.size(); i++) {
+    for (int i = 0; i < country.unitCount.size(); i++) {
       // run unit generation ("unitCount")[i] times
-      for (int x = 0; x < country.second.unitCount[i]; x++) {
+      for (int x = 0; x < country.unitCount[i]; x++) {
         // copy the template unit file
         auto tempUnit{unitBlock};
         // replace division name with the generic division name
@@ -536,44 +546,45 @@ void historyUnits(const std::string &path, const hoiMap &countries) {
         // now deploy the unit in a random province
         ParserUtils::replaceOccurences(
             tempUnit, "templateLocation",
-            std::to_string(country.second.hoi4Regions[0].gameProvinces[0].ID +
-                           1));
+            std::to_string(
+                hoi4Regions[country.ownedRegions[0]].provinces[0]->ID +
+                1));
         totalUnits += tempUnit;
       }
     }
 
-    // for (int i = 0; i < country.second.attributeVectors.at("units").size();
+    // for (int i = 0; i < country.attributeVectors.at("units").size();
     // i++) {
     //
-    //	for (int x = 0; x < country.second.attributeVectors.at("unitCount")[i];
+    //	for (int x = 0; x < country.attributeVectors.at("unitCount")[i];
     // x++) {
-    // Logging::logLine(country.second.attributeVectors.at("units")[i]);
+    // Tracing::logLine(country.attributeVectors.at("units")[i]);
     // auto
     // tempUnit{ unitBlock }; 		ParserUtils::replaceOccurences(tempUnit,
     //"templateDivisionName", IDMap.at(i));
-    // Logging::logLine(IDMap.at(i));
+    // Tracing::logLine(IDMap.at(i));
     // ParserUtils::replaceOccurences(tempUnit,
     //"templateLocation",
-    // std::to_string(country.second.ownedRegions[0].gameProvinces[0].ID + 1));
+    // std::to_string(country.ownedRegions[0].gameProvinces[0].ID + 1));
     //		totalUnits += tempUnit;
     //	}
     //}
     ParserUtils::replaceOccurences(unitFile, "templateUnitBlock", totalUnits);
     // units
-    auto tempPath = path + country.first + "_1936.txt";
+    auto tempPath = path + country.tag + "_1936.txt";
     pU::writeFile(tempPath, unitFile);
 
     // navies
-    tempPath = path + country.first + "_1936_naval.txt";
+    tempPath = path + country.tag + "_1936_naval.txt";
     pU::writeFile(tempPath, "");
-    tempPath = path + country.first + "_1936_naval_mtg.txt";
+    tempPath = path + country.tag + "_1936_naval_mtg.txt";
     pU::writeFile(tempPath, "");
   }
 }
 
 void commonBookmarks(
     const std::string &path, const hoiMap &countries,
-    const std::map<int, std::vector<std::string>> &strengthScores) {
+    const std::map<int, std::vector<CountryId>> &strengthScores) {
   auto bookmarkTemplate = pU::readFile(
       "resources\\hoi4\\common\\bookmarks\\the_gathering_storm.txt");
   int count = 0;
@@ -588,16 +599,16 @@ void commonBookmarks(
        ++iter) {
     if (count == 0) {
       pU::replaceOccurences(bookmarkTemplate, "templateDefaultTAG",
-                            iter->second[0]);
+                            countries[iter->second[0]].tag);
     }
     if (count < 7) {
       // major power:
       for (const auto &country : iter->second) {
         auto majorString{majorTemplate};
         pU::replaceOccurences(majorString, "templateIdeology",
-                              countries.at(country).rulingParty);
-        bookmarkCountries.append(
-            pU::replaceOccurences(majorString, "templateMajorTAG", country));
+                              countries[country].rulingParty);
+        bookmarkCountries.append(pU::replaceOccurences(
+            majorString, "templateMajorTAG", countries[country].tag));
         count++;
       }
     } else if (count < 14) {
@@ -605,9 +616,9 @@ void commonBookmarks(
       for (const auto &country : iter->second) {
         auto minorString{minorTemplate};
         pU::replaceOccurences(minorString, "templateIdeology",
-                              countries.at(country).rulingParty);
-        bookmarkCountries.append(
-            pU::replaceOccurences(minorString, "templateMinorTAG", country));
+                              countries[country].rulingParty);
+        bookmarkCountries.append(pU::replaceOccurences(
+            minorString, "templateMinorTAG", countries[country].tag));
         count++;
       }
     }
@@ -619,23 +630,23 @@ void commonBookmarks(
 
 void commonCountries(const std::string &path, const std::string &hoiPath,
                      const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: Common: Writing Countries");
+  Tracing::logLine("HOI4 Parser: Common: Writing Countries");
   const auto content =
       pU::readFile("resources\\hoi4\\common\\country_default.txt");
   const auto colorsTxtTemplate =
       pU::readFile("resources\\hoi4\\common\\colors.txt");
   std::string colorsTxt = pU::readFile(hoiPath);
   for (const auto &country : countries) {
-    auto tempPath = path + country.second.name + ".txt";
+    auto tempPath = path + country.name + ".txt";
     auto countryText{content};
     auto colourString = pU::replaceOccurences(
-        Utils::varsToString(country.second.colour), ";", " ");
+        Utils::varsToString(country.colour), ";", " ");
     pU::replaceOccurences(countryText, "templateCulture",
-                          country.second.gfxCulture);
+                          country.gfxCulture);
     pU::replaceOccurences(countryText, "templateColour", colourString);
     pU::writeFile(tempPath, countryText);
     auto templateCopy{colorsTxtTemplate};
-    pU::replaceOccurences(templateCopy, "templateTag", country.first);
+    pU::replaceOccurences(templateCopy, "templateTag", country.tag);
     pU::replaceOccurences(templateCopy, "templateColour", colourString);
     colorsTxt.append(templateCopy);
   }
@@ -643,17 +654,17 @@ void commonCountries(const std::string &path, const std::string &hoiPath,
 }
 
 void commonCountryTags(const std::string &path, const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: Common: Writing Country Tags");
+  Tracing::logLine("HOI4 Parser: Common: Writing Country Tags");
   std::string content = "";
   for (const auto &country : countries)
-    content.append(country.first + " = countries/" + country.second.name +
+    content.append(country.tag + " = countries/" + country.name +
                    ".txt\n");
   pU::writeFile(path, content);
 }
 
 void countryNames(const std::string &path, const hoiMap &countries,
                   const NameGeneration::NameData &nData) {
-  Logging::logLine("HOI4 Parser: Localisation: Writing Country Names");
+  Tracing::logLine("HOI4 Parser: Localisation: Writing Country Names");
   std::string content = "l_english:\n";
   std::vector<std::string> ideologies{"fascism", "communism", "neutrality",
                                       "democratic"};
@@ -661,28 +672,29 @@ void countryNames(const std::string &path, const hoiMap &countries,
   for (const auto &c : countries) {
     for (const auto &ideology : ideologies) {
       auto ideologyName = NameGeneration::modifyWithIdeology(
-          ideology, c.second.name, c.second.adjective, nData);
+          ideology, c.name, c.adjective, nData);
       content +=
-          " " + c.first + "_" + ideology + ":0 \"" + ideologyName + "\"\n";
+          " " + c.tag + "_" + ideology + ":0 \"" + ideologyName + "\"\n";
       content +=
-          " " + c.first + "_" + ideology + "_DEF:0 \"" + ideologyName + "\"\n";
+          " " + c.tag + "_" + ideology + "_DEF:0 \"" + ideologyName + "\"\n";
       ;
-      content += " " + c.first + "_" + ideology + "_ADJ:0 \"" +
-                 c.second.adjective + "\"\n";
+      content += " " + c.tag + "_" + ideology + "_ADJ:0 \"" +
+                 c.adjective + "\"\n";
       ;
     }
   }
   pU::writeFile(path + "countries_l_english.yml", content, true);
 }
 
-void stateNames(const std::string &path, const hoiMap &countries) {
-  Logging::logLine("HOI4 Parser: Localisation: Writing State Names");
+void stateNames(const std::string &path, const hoiMap &countries,
+                const std::vector<Region> &hoi4Regions) {
+  Tracing::logLine("HOI4 Parser: Localisation: Writing State Names");
   std::string content = "l_english:\n";
 
   for (const auto &c : countries) {
-    for (const auto &region : c.second.hoi4Regions)
-      content += " STATE_" + std::to_string(region.ID + 1) + ":0 \"" +
-                 region.name + "\"\n";
+    for (const auto &regionID : c.ownedRegions)
+      content += " STATE_" + std::to_string(regionID + 1) + ":0 \"" +
+                 hoi4Regions[regionID].name + "\"\n";
   }
   pU::writeFile(path + "state_names_l_english.yml", content, true);
 }
@@ -690,7 +702,7 @@ void stateNames(const std::string &path, const hoiMap &countries) {
 void strategicRegionNames(
     const std::string &path,
     const std::vector<strategicRegion> &strategicRegions) {
-  Logging::logLine("HOI4 Parser: Map: Naming the Regions");
+  Tracing::logLine("HOI4 Parser: Map: Naming the Regions");
   std::string content = "l_english:\n";
   for (auto i = 0; i < strategicRegions.size(); i++) {
     content += Utils::varsToString(" STRATEGICREGION_", i, ":0 \"",
@@ -705,7 +717,7 @@ void tutorials(const std::string &path) {
 
 void foci(const std::string &path, const hoiMap &countries,
           const NameGeneration::NameData &nData) {
-  Logging::logLine("HOI4 Parser: History: Demanding Danzig");
+  Tracing::logLine("HOI4 Parser: History: Demanding Danzig");
   const auto focusTypes = ParserUtils::getLines(
       "resources\\hoi4\\ai\\national_focus\\baseFiles\\foci.txt");
   std::string baseTree = ParserUtils::readFile(
@@ -719,7 +731,7 @@ void foci(const std::string &path, const hoiMap &countries,
   for (const auto &c : countries) {
     std::string treeContent = baseTree;
     std::string tempContent = "";
-    for (const auto &focusChain : c.second.foci) {
+    for (const auto &focusChain : c.foci) {
       for (const auto &countryFocus : focusChain) {
         tempContent += focusTemplates[(size_t)countryFocus.fType];
 
@@ -753,15 +765,15 @@ void foci(const std::string &path, const hoiMap &countries,
         ParserUtils::replaceOccurences(tempContent, "templateChainID",
                                        std::to_string(countryFocus.chainID));
         ParserUtils::replaceOccurences(tempContent, "templateSourceTag",
-                                       c.first);
+                                       c.tag);
         ParserUtils::replaceOccurences(tempContent, "templateSourcename",
-                                       c.second.name);
+                                       c.name);
         ParserUtils::replaceOccurences(tempContent, "templateDestTag",
                                        countryFocus.destTag);
         // need a faction name
         if (tempContent.find("templateFactionname") != std::string::npos) {
           auto facName = NameGeneration::generateFactionName(
-              c.second.rulingParty, c.second.name, c.second.adjective, nData);
+              c.rulingParty, c.name, c.adjective, nData);
           ParserUtils::replaceOccurences(tempContent, "templateFactionname",
                                          facName);
         }
@@ -816,7 +828,7 @@ void foci(const std::string &path, const hoiMap &countries,
               preRequisiteBlocks[counter++].push_back(aBlock[0]);
             }
             std::string preName = Utils::varsToString(
-                c.first, focusChain[0].chainID, ".", aBlock[0]);
+                c.tag, focusChain[0].chainID, ".", aBlock[0]);
 
             preString += "prerequisite = {";
             preString += " focus = " + preName + " }\n\t\t";
@@ -826,7 +838,7 @@ void foci(const std::string &path, const hoiMap &countries,
           preString += "prerequisite = {";
           for (const auto &elem : usedF) {
             std::string preName =
-                Utils::varsToString(c.first, focusChain[0].chainID, ".", elem);
+                Utils::varsToString(c.tag, focusChain[0].chainID, ".", elem);
             preString += " focus = " + preName + " ";
           }
           preString += "}\n";
@@ -849,7 +861,7 @@ void foci(const std::string &path, const hoiMap &countries,
             if (foc.stepID == exclusive) {
               // derive the name of the preceding focus
               std::string preName = Utils::varsToString(
-                  c.first, focusChain[0].chainID, ".", exclusive);
+                  c.tag, focusChain[0].chainID, ".", exclusive);
               preString += " focus = " + preName;
             }
           }
@@ -861,8 +873,8 @@ void foci(const std::string &path, const hoiMap &countries,
     }
     ParserUtils::replaceOccurences(treeContent, "templateFocusTree",
                                    tempContent);
-    ParserUtils::replaceOccurences(treeContent, "templateSourceTag", c.first);
-    ParserUtils::writeFile(path + c.second.name + ".txt", treeContent);
+    ParserUtils::replaceOccurences(treeContent, "templateSourceTag", c.tag);
+    ParserUtils::writeFile(path + c.name + ".txt", treeContent);
   }
 }
 
@@ -0,0 +1,414 @@
+#include "hoi4/Hoi4Snapshot.h"
+namespace Scenario::Hoi4 {
+using Snapshot::Reader;
+using Snapshot::Writer;
+// pointers to provinces are stored as their index in fwg.areas.provinces
+using ProvinceIndices = std::map<const Fwg::Province *, int>;
+
+static void write(Writer &w, const Fwg::Gfx::Bitmap &bitmap) {
+  w.write(bitmap.bInfoHeader.biWidth);
+  w.write(bitmap.bInfoHeader.biHeight);
+  w.write(bitmap.bInfoHeader.biBitCount);
+  w.write(bitmap.imageData);
+  w.write(bitmap.bit8Buffer);
+  w.write(bitmap.colourtable);
+}
+
+static void read(Reader &r, Fwg::Gfx::Bitmap &bitmap) {
+  const auto width = r.get<int>();
+  const auto height = r.get<int>();
+  const auto bitCount = r.get<int>();
+  bitmap = Fwg::Gfx::Bitmap(width, height, bitCount);
+  r.read(bitmap.imageData);
+  r.read(bitmap.bit8Buffer);
+  r.read(bitmap.colourtable);
+}
+
+static void write(Writer &w, const boost::dynamic_bitset<> &bits) {
+  std::vector<boost::dynamic_bitset<>::block_type> blocks(bits.num_blocks());
+  boost::to_block_range(bits, blocks.begin());
+  w.write(bits.size());
+  w.write(blocks);
+}
+
+static void read(Reader &r, boost::dynamic_bitset<> &bits) {
+  const auto size = r.get<size_t>();
+  const auto blocks =
+      r.get<std::vector<boost::dynamic_bitset<>::block_type>>();
+  bits = boost::dynamic_bitset<>(blocks.begin(), blocks.end());
+  bits.resize(size);
+}
+
+static void write(Writer &w, const std::vector<Fwg::Province *> &provinces,
+                  const ProvinceIndices &indices) {
+  w.write(provinces.size());
+  for (const auto province : provinces)
+    w.write(indices.at(province));
+}
+
+static void read(Reader &r, std::vector<Fwg::Province *> &provinces,
+                 std::deque<Fwg::Province> &provinceStore) {
+  provinces.resize(r.get<size_t>());
+  for (auto &province : provinces)
+    province = &provinceStore.at(r.get<int>());
+}
+
+static void write(Writer &w, const Fwg::Province &province,
+                  const ProvinceIndices &indices) {
+  w.write(province.ID);
+  w.write(province.colour);
+  w.write(province.sea);
+  w.write(province.isLake);
+  w.write(province.coastal);
+  w.write(province.pixels);
+  w.write(province.coastalPixels);
+  w.write(province.cityPixels);
+  write(w, province.neighbours, indices);
+  w.write(province.position);
+  w.write(province.continentID);
+  w.write(province.landMassID);
+  w.write(province.weatherMonths);
+}
+
+static void read(Reader &r, Fwg::Province &province,
+                 std::deque<Fwg::Province> &provinceStore) {
+  r.read(province.ID);
+  r.read(province.colour);
+  r.read(province.sea);
+  r.read(province.isLake);
+  r.read(province.coastal);
+  r.read(province.pixels);
+  r.read(province.coastalPixels);
+  r.read(province.cityPixels);
+  read(r, province.neighbours, provinceStore);
+  r.read(province.position);
+  r.read(province.continentID);
+  r.read(province.landMassID);
+  r.read(province.weatherMonths);
+}
+
+static void write(Writer &w, const GameProvince &gameProvince,
+                  const ProvinceIndices &indices) {
+  w.write(gameProvince.ID);
+  w.write(gameProvince.name);
+  w.write(gameProvince.baseProvince == nullptr
+              ? -1
+              : indices.at(gameProvince.baseProvince));
+}
+
+static void read(Reader &r, GameProvince &gameProvince,
+                 std::deque<Fwg::Province> &provinceStore) {
+  r.read(gameProvince.ID);
+  r.read(gameProvince.name);
+  const auto baseIndex = r.get<int>();
+  gameProvince.baseProvince =
+      baseIndex == -1 ? nullptr : &provinceStore.at(baseIndex);
+}
+
+static void write(Writer &w, const Hoi4::Region &region,
+                  const ProvinceIndices &indices) {
+  // base region
+  w.write(region.ID);
+  w.write(region.sea);
+  write(w, region.provinces, indices);
+  w.write(region.neighbours);
+  w.write(region.position);
+  // game region
+  w.write(region.owner);
+  w.write(region.name);
+  w.write(region.assigned);
+  w.write(region.temperatureRange);
+  w.write(region.dateRange);
+  w.write(region.snowChance);
+  w.write(region.lightRainChance);
+  w.write(region.heavyRainChance);
+  w.write(region.blizzardChance);
+  w.write(region.mudChance);
+  w.write(region.sandStormChance);
+  // hoi4 region
+  w.write(region.armsFactories);
+  w.write(region.civilianFactories);
+  w.write(region.development);
+  w.write(region.dockyards);
+  w.write(region.population);
+  w.write(region.resources);
+  w.write(region.stateCategory);
+  w.write(region.stratID);
+}
+
+static void read(Reader &r, Hoi4::Region &region,
+                 std::deque<Fwg::Province> &provinceStore) {
+  r.read(region.ID);
+  r.read(region.sea);
+  read(r, region.provinces, provinceStore);
+  r.read(region.neighbours);
+  r.read(region.position);
+  r.read(region.owner);
+  r.read(region.name);
+  r.read(region.assigned);
+  r.read(region.temperatureRange);
+  r.read(region.dateRange);
+  r.read(region.snowChance);
+  r.read(region.lightRainChance);
+  r.read(region.heavyRainChance);
+  r.read(region.blizzardChance);
+  r.read(region.mudChance);
+  r.read(region.sandStormChance);
+  r.read(region.armsFactories);
+  r.read(region.civilianFactories);
+  r.read(region.development);
+  r.read(region.dockyards);
+  r.read(region.population);
+  r.read(region.resources);
+  r.read(region.stateCategory);
+  r.read(region.stratID);
+}
+
+static void write(Writer &w, const NationalFocus &focus) {
+  w.write(focus.ID);
+  w.write(focus.stepID);
+  w.write(focus.chainID);
+  w.write(focus.fType);
+  w.write(focus.sourceTag);
+  w.write(focus.destTag);
+  w.write(focus.defaultV);
+  w.write(focus.date);
+  w.write(focus.position);
+  w.write(focus.precedingFoci);
+  w.write(focus.andFoci);
+  w.write(focus.xorFoci);
+  w.write(focus.orFoci);
+  w.write(focus.available);
+  w.write(focus.bypasses);
+  w.write(focus.completionRewards);
+}
+
+static void read(Reader &r, NationalFocus &focus) {
+  r.read(focus.ID);
+  r.read(focus.stepID);
+  r.read(focus.chainID);
+  r.read(focus.fType);
+  r.read(focus.sourceTag);
+  r.read(focus.destTag);
+  r.read(focus.defaultV);
+  r.read(focus.date);
+  r.read(focus.position);
+  r.read(focus.precedingFoci);
+  r.read(focus.andFoci);
+  r.read(focus.xorFoci);
+  r.read(focus.orFoci);
+  r.read(focus.available);
+  r.read(focus.bypasses);
+  r.read(focus.completionRewards);
+}
+
+static void write(Writer &w, const Hoi4Country &country) {
+  // generic country
+  w.write(country.ID);
+  w.write(country.tag);
+  w.write(country.name);
+  w.write(country.adjective);
+  w.write(country.capitalRegionID);
+  w.write(country.developmentFactor);
+  w.write(country.flagIndex);
+  w.write(country.colour);
+  w.write(country.ownedRegions);
+  write(w, country.neighbours);
+  // hoi4 country
+  w.write(country.fullName);
+  w.write(country.gfxCulture);
+  w.write(country.rank);
+  w.write(country.rulingParty);
+  w.write(country.allowElections);
+  w.write(country.bully);
+  w.write(country.strengthScore);
+  w.write(country.relativeScore);
+  w.write(country.doctrines);
+  w.write(country.units);
+  w.write(country.unitCount);
+  w.write(country.parties);
+  w.write(country.foci.size());
+  for (const auto &chain : country.foci) {
+    w.write(chain.size());
+    for (const auto &focus : chain)
+      write(w, focus);
+  }
+}
+
+static Hoi4Country readCountry(Reader &r) {
+  // the full constructor draws a random colour, which would advance RandNum
+  PdoxCountry base;
+  r.read(base.ID);
+  r.read(base.tag);
+  r.read(base.name);
+  r.read(base.adjective);
+  r.read(base.capitalRegionID);
+  r.read(base.developmentFactor);
+  r.read(base.flagIndex);
+  r.read(base.colour);
+  r.read(base.ownedRegions);
+  read(r, base.neighbours);
+  Hoi4Country country(base);
+  r.read(country.fullName);
+  r.read(country.gfxCulture);
+  r.read(country.rank);
+  r.read(country.rulingParty);
+  r.read(country.allowElections);
+  r.read(country.bully);
+  r.read(country.strengthScore);
+  r.read(country.relativeScore);
+  r.read(country.doctrines);
+  r.read(country.units);
+  r.read(country.unitCount);
+  r.read(country.parties);
+  country.foci.resize(r.get<size_t>());
+  for (auto &chain : country.foci) {
+    chain.resize(r.get<size_t>());
+    for (auto &focus : chain)
+      read(r, focus);
+  }
+  return country;
+}
+
+void saveSnapshot(const std::string &path, const Generator &hoi4Gen) {
+  Fwg::Utils::Logging::logLine("HOI4: Saving snapshot to ", path);
+  Writer w(path, "Hoi4");
+  const auto &config = Fwg::Cfg::Values();
+  w.write(config.width);
+  w.write(config.height);
+  const auto &fwg = *hoi4Gen.fwg;
+  for (const auto &bitmap :
+       {&fwg.climateMap, &fwg.riverMap, &fwg.treeMap, &fwg.heightMap,
+        &fwg.summerMap, &fwg.cityMap, &fwg.sobelMap, &fwg.provinceMap})
+    write(w, *bitmap);
+  // provinces first, everything else refers to them
+  ProvinceIndices indices;
+  for (auto i = 0; i < fwg.areas.provinces.size(); i++)
+    indices[fwg.areas.provinces[i]] = i;
+  w.write(fwg.areas.provinces.size());
+  for (const auto province : fwg.areas.provinces)
+    write(w, *province, indices);
+  w.write(fwg.areas.regions.size());
+  for (const auto &region : fwg.areas.regions) {
+    w.write(region.ID);
+    w.write(region.sea);
+    write(w, region.provinces, indices);
+    w.write(region.neighbours);
+    w.write(region.position);
+  }
+  w.write(fwg.areas.continents.size());
+  for (const auto &continent : fwg.areas.continents) {
+    w.write(continent.ID);
+    write(w, continent.provinces, indices);
+  }
+  // the scenario, the adjacency of the province table is rebuilt on load
+  const auto &provinceTable = hoi4Gen.provinceTable;
+  w.write(provinceTable.owners);
+  w.write(provinceTable.terrainIDs);
+  w.write(provinceTable.popFactors);
+  w.write(provinceTable.devFactors);
+  w.write(provinceTable.cityShares);
+  w.write(provinceTable.doubleAttributes);
+  w.write(provinceTable.stringAttributes);
+  w.write(provinceTable.doubleAttributeIDs);
+  w.write(provinceTable.stringAttributeIDs);
+  w.write(hoi4Gen.gameProvinces.size());
+  for (const auto &gameProvince : hoi4Gen.gameProvinces)
+    write(w, gameProvince, indices);
+  w.write(hoi4Gen.hoi4Regions.size());
+  for (const auto &region : hoi4Gen.hoi4Regions)
+    write(w, region, indices);
+  w.write(hoi4Gen.hoi4Countries.size());
+  for (const auto &country : hoi4Gen.hoi4Countries)
+    write(w, country);
+  w.write(hoi4Gen.flagAtlas.width);
+  w.write(hoi4Gen.flagAtlas.height);
+  w.write(hoi4Gen.flagAtlas.pixels);
+  w.write(hoi4Gen.strategicRegions.size());
+  for (const auto &strategicRegion : hoi4Gen.strategicRegions) {
+    w.write(strategicRegion.gameRegionIDs);
+    w.write(strategicRegion.weatherMonths);
+    w.write(strategicRegion.name);
+  }
+  w.write(hoi4Gen.supplyNodeConnections);
+  w.write(hoi4Gen.strengthScores);
+}
+
+void loadSnapshot(const std::string &path, Generator &hoi4Gen,
+                  std::deque<Fwg::Province> &provinceStore) {
+  Fwg::Utils::Logging::logLine("HOI4: Loading snapshot from ", path);
+  Reader r(path, "Hoi4");
+  // the writers take the map size from the config, not from the maps
+  const auto &config = Fwg::Cfg::Values();
+  const auto width = r.get<int>();
+  const auto height = r.get<int>();
+  if (width != config.width || height != config.height) {
+    const auto error = "The snapshot has a map size of " +
+                       std::to_string(width) + "x" + std::to_string(height) +
+                       ", but the config has " + std::to_string(config.width) +
+                       "x" + std::to_string(config.height);
+    throw(std::exception(error.c_str()));
+  }
+  hoi4Gen.fwg = std::make_shared<Fwg::FastWorldGenerator>();
+  auto &fwg = *hoi4Gen.fwg;
+  for (auto bitmap :
+       {&fwg.climateMap, &fwg.riverMap, &fwg.treeMap, &fwg.heightMap,
+        &fwg.summerMap, &fwg.cityMap, &fwg.sobelMap, &fwg.provinceMap})
+    read(r, *bitmap);
+  // all provinces have to exist before their neighbours can point to them
+  provinceStore.clear();
+  provinceStore.resize(r.get<size_t>());
+  fwg.areas.provinces.clear();
+  for (auto &province : provinceStore) {
+    read(r, province, provinceStore);
+    fwg.areas.provinces.push_back(&province);
+  }
+  fwg.areas.regions.resize(r.get<size_t>());
+  for (auto &region : fwg.areas.regions) {
+    r.read(region.ID);
+    r.read(region.sea);
+    read(r, region.provinces, provinceStore);
+    r.read(region.neighbours);
+    r.read(region.position);
+  }
+  fwg.areas.continents.resize(r.get<size_t>());
+  for (auto &continent : fwg.areas.continents) {
+    r.read(continent.ID);
+    read(r, continent.provinces, provinceStore);
+  }
+  // the scenario
+  auto &provinceTable = hoi4Gen.provinceTable;
+  provinceTable.build(fwg.areas.provinces,
+                    fwg.provinceMap.bInfoHeader.biWidth);
+  r.read(provinceTable.owners);
+  r.read(provinceTable.terrainIDs);
+  r.read(provinceTable.popFactors);
+  r.read(provinceTable.devFactors);
+  r.read(provinceTable.cityShares);
+  r.read(provinceTable.doubleAttributes);
+  r.read(provinceTable.stringAttributes);
+  r.read(provinceTable.doubleAttributeIDs);
+  r.read(provinceTable.stringAttributeIDs);
+  hoi4Gen.gameProvinces.resize(r.get<size_t>());
+  for (auto &gameProvince : hoi4Gen.gameProvinces)
+    read(r, gameProvince, provinceStore);
+  hoi4Gen.hoi4Regions.resize(r.get<size_t>());
+  for (auto &region : hoi4Gen.hoi4Regions)
+    read(r, region, provinceStore);
+  hoi4Gen.hoi4Countries.clear();
+  const auto countryCount = r.get<size_t>();
+  for (auto i = 0; i < countryCount; i++)
+    hoi4Gen.hoi4Countries.push_back(readCountry(r));
+  r.read(hoi4Gen.flagAtlas.width);
+  r.read(hoi4Gen.flagAtlas.height);
+  r.read(hoi4Gen.flagAtlas.pixels);
+  hoi4Gen.strategicRegions.resize(r.get<size_t>());
+  for (auto &strategicRegion : hoi4Gen.strategicRegions) {
+    r.read(strategicRegion.gameRegionIDs);
+    r.read(strategicRegion.weatherMonths);
+    r.read(strategicRegion.name);
+  }
+  r.read(hoi4Gen.supplyNodeConnections);
+  r.read(hoi4Gen.strengthScores);
+}
+} // namespace Scenario::Hoi4